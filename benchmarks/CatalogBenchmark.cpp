@@ -0,0 +1,162 @@
+/**
+ * @file CatalogBenchmark.cpp
+ * @brief Lookups and full scans over a large catalog: the old
+ *        unique_ptr<Product> hierarchy against the variant storage
+ *
+ * Usage: catalog_benchmark [skus]
+ * Defaults to 50,000 SKUs, half coffee and half snacks. Build with
+ * optimizations (-DCMAKE_BUILD_TYPE=Release) for meaningful numbers.
+ */
+
+#include "../utils/FileManager.h"
+#include "../controllers/ProductController.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr int RUNS = 5;
+constexpr long LOOKUPS = 10000000;
+constexpr int SCANS = 200;
+
+// The storage before the variant: one heap node per product, an index
+// from ID to slot, and a virtual call for everything type-specific
+struct HierarchyCatalog {
+    std::vector<std::unique_ptr<Product>> products;
+    std::unordered_map<int, std::size_t> index;
+
+    const Product* getById(int id) const {
+        auto it = index.find(id);
+        return it == index.end() ? nullptr : products[it->second].get();
+    }
+};
+
+Money priceOf(int sku) {
+    return 9000 + (sku % 40) * 500;
+}
+
+// Random IDs drawn once, so both sides look up the same sequence
+std::vector<int> makeLookups(int skus) {
+    std::vector<int> ids;
+    ids.reserve(LOOKUPS);
+    std::uint32_t state = 12345;
+    for (long i = 0; i < LOOKUPS; ++i) {
+        state = state * 1664525u + 1013904223u;
+        ids.push_back(1 + static_cast<int>(state % static_cast<std::uint32_t>(skus)));
+    }
+    return ids;
+}
+
+long long lookupHierarchy(const HierarchyCatalog& catalog, const std::vector<int>& ids) {
+    long long checksum = 0;
+    for (int id : ids) {
+        checksum += catalog.getById(id)->calculatePrice(2);
+    }
+    return checksum;
+}
+
+long long lookupVariant(const ProductController& catalog, const std::vector<int>& ids) {
+    long long checksum = 0;
+    for (int id : ids) {
+        checksum += catalog.getById(id)->calculatePrice(2);
+    }
+    return checksum;
+}
+
+long long scanHierarchy(const HierarchyCatalog& catalog) {
+    long long checksum = 0;
+    for (int scan = 0; scan < SCANS; ++scan) {
+        for (const auto& product : catalog.products) {
+            checksum += product->calculatePrice(1) +
+                        static_cast<long long>(product->getExtraField().size());
+        }
+    }
+    return checksum;
+}
+
+long long scanVariant(const ProductController& catalog) {
+    long long checksum = 0;
+    for (int scan = 0; scan < SCANS; ++scan) {
+        for (const auto& product : catalog.getCatalog()) {
+            checksum += std::visit([](const auto& concrete) {
+                return concrete.calculatePrice(1) +
+                       static_cast<long long>(concrete.getExtraField().size());
+            }, product);
+        }
+    }
+    return checksum;
+}
+
+// Best of RUNS, reported as millions of operations per second
+template<typename Work>
+long long run(const char* name, double operations, Work work) {
+    long long checksum = 0;
+    double best = 0;
+    for (int i = 0; i < RUNS; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        checksum = work();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+
+    std::printf("%-32s %8.3f s  %10.1f M ops/s\n", name, best, operations / best / 1e6);
+    return checksum;
+}
+
+bool compare(const char* what, long long hierarchy, long long variant) {
+    if (hierarchy == variant) {
+        return true;
+    }
+    std::printf("%s checksums differ: %lld vs %lld\n", what, hierarchy, variant);
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int skus = (argc > 1) ? std::atoi(argv[1]) : 50000;
+    if (skus <= 0) {
+        std::printf("Usage: catalog_benchmark [skus]\n");
+        return 1;
+    }
+
+    // Nothing is loaded or saved; the controller only needs a directory
+    FileManager fileManager("bench-data/");
+    ProductController variant(fileManager);
+    HierarchyCatalog hierarchy;
+    hierarchy.products.reserve(skus);
+
+    for (int sku = 1; sku <= skus; ++sku) {
+        std::string name = "Product " + std::to_string(sku);
+        if (sku % 2 == 0) {
+            hierarchy.products.push_back(std::make_unique<Coffee>(sku, name, priceOf(sku), "double"));
+            variant.add(Coffee(sku, name, priceOf(sku), "double"));
+        } else {
+            hierarchy.products.push_back(std::make_unique<Snack>(sku, name, priceOf(sku), "pastry"));
+            variant.add(Snack(sku, name, priceOf(sku), "pastry"));
+        }
+        hierarchy.index[sku] = hierarchy.products.size() - 1;
+    }
+
+    std::printf("Catalog of %d SKUs, %ld lookups, %d full scans\n", skus, LOOKUPS, SCANS);
+    std::vector<int> ids = makeLookups(skus);
+    double scanned = static_cast<double>(skus) * SCANS;
+
+    long long oldLookup = run("lookup: unique_ptr (old)", LOOKUPS, [&] { return lookupHierarchy(hierarchy, ids); });
+    long long newLookup = run("lookup: variant (new)", LOOKUPS, [&] { return lookupVariant(variant, ids); });
+    long long oldScan = run("scan: unique_ptr (old)", scanned, [&] { return scanHierarchy(hierarchy); });
+    long long newScan = run("scan: variant (new)", scanned, [&] { return scanVariant(variant); });
+
+    bool same = compare("Lookup", oldLookup, newLookup);
+    same = compare("Scan", oldScan, newScan) && same;
+
+    return same ? 0 : 1;
+}
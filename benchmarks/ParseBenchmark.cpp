@@ -0,0 +1,143 @@
+/**
+ * @file ParseBenchmark.cpp
+ * @brief Lines per second loading transactions.txt: the old splitLine/stoi
+ *        path against the string_view tokenizer
+ *
+ * Usage: parse_benchmark [rows] [directory]
+ * Defaults to 10,000,000 rows written under ./bench-data/. Build with
+ * optimizations (-DCMAKE_BUILD_TYPE=Release) for meaningful numbers.
+ */
+
+#include "../utils/FileManager.h"
+#include "../models/Transaction.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char* FILENAME = "transactions.txt";
+
+// Writes `rows` transactions in the on-disk format, streamed so the file
+// never has to fit in memory
+void writeTransactions(const std::string& path, long rows) {
+    std::ofstream file(path, std::ios::trunc | std::ios::binary);
+    std::string buffer;
+    for (long i = 1; i <= rows; ++i) {
+        int items = 1 + static_cast<int>(i % 4);
+        buffer += std::to_string(i);
+        buffer += '|';
+        buffer += std::to_string(i % 500);
+        buffer += "|2025-01-15 10:30:00|";
+        buffer += std::to_string(18000 * items);
+        buffer += '|';
+        buffer += std::to_string(18 * items);
+        buffer += "|0|";
+        for (int item = 0; item < items; ++item) {
+            if (item > 0) {
+                buffer += ',';
+            }
+            buffer += std::to_string(1 + (i + item) % 14);
+            buffer += ":1";
+        }
+        buffer += '\n';
+
+        if (buffer.size() > (1 << 20)) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+// The load path before the tokenizer: a string per line, splitLine's
+// stringstream and field vector, std::stoi/std::stod on the copies. Lines
+// are copied one at a time instead of through readLines(), which would
+// hold the whole file as strings.
+long long parseLegacy(const FileManager& fileManager, long& rows) {
+    long long checksum = 0;
+    rows = 0;
+    for (std::string_view view : fileManager.mapFile(FILENAME)) {
+        std::string line(view);
+        std::vector<std::string> fields = FileManager::splitLine(line, '|');
+        if (fields.size() < 7) {
+            continue;
+        }
+
+        Transaction transaction;
+        transaction.setId(std::stoi(fields[0]));
+        transaction.setCustomerId(std::stoi(fields[1]));
+        transaction.setDateTime(fields[2]);
+        double total = std::stod(fields[3]);
+        int pointsEarned = std::stoi(fields[4]);
+        transaction.setPointsUsed(std::stoi(fields[5]));
+
+        for (const auto& entry : FileManager::splitLine(fields[6], ',')) {
+            std::vector<std::string> parts = FileManager::splitLine(entry, ':');
+            if (parts.size() >= 2) {
+                transaction.addItem(TransactionItem(std::stoi(parts[0]), "", 0, std::stoi(parts[1])));
+            }
+        }
+
+        checksum += transaction.getId() + static_cast<long long>(total) + pointsEarned +
+                    static_cast<long long>(transaction.getItems().size());
+        ++rows;
+    }
+    return checksum;
+}
+
+// The current load path: mapped file, string_view fields, from_chars
+long long parseCurrent(const FileManager& fileManager, long& rows) {
+    long long checksum = 0;
+    rows = 0;
+    for (std::string_view line : fileManager.mapFile(FILENAME)) {
+        Transaction transaction;
+        transaction.deserialize(line);
+        if (!transaction.isValid()) {
+            continue;
+        }
+
+        checksum += transaction.getId() + transaction.getTotal() + transaction.getPointsEarned() +
+                    static_cast<long long>(transaction.getItems().size());
+        ++rows;
+    }
+    return checksum;
+}
+
+template<typename Parse>
+long long run(const char* name, const FileManager& fileManager, Parse parse) {
+    long rows = 0;
+    auto start = std::chrono::steady_clock::now();
+    long long checksum = parse(fileManager, rows);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%-32s %10ld rows  %8.2f s  %12.0f lines/s\n",
+                name, rows, seconds, rows / seconds);
+    return checksum;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long rows = (argc > 1) ? std::atol(argv[1]) : 10000000;
+    std::string dir = (argc > 2) ? argv[2] : "bench-data";
+    std::filesystem::create_directories(dir);
+    dir += '/';
+
+    FileManager fileManager(dir);
+    std::printf("Writing %ld transactions to %s%s\n", rows, dir.c_str(), FILENAME);
+    writeTransactions(dir + FILENAME, rows);
+
+    long long legacy = run("splitLine + stoi (old)", fileManager, parseLegacy);
+    long long current = run("splitFields + from_chars (new)", fileManager, parseCurrent);
+
+    if (legacy != current) {
+        std::printf("Checksums differ: %lld vs %lld\n", legacy, current);
+        return 1;
+    }
+    return 0;
+}
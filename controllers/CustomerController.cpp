@@ -9,21 +9,18 @@
 
 CustomerController::CustomerController(FileManager& fileManager)
     : m_fileManager(fileManager)
+    , m_table(fileManager, FILENAME, JOURNAL_FILENAME, RECORD_SIZE_HINT)
 {
 }
 
 std::vector<Customer> CustomerController::getAll() const {
-    return m_customers;
+    return m_customers.values();
 }
 
 Customer* CustomerController::getById(int id) {
-    auto it = std::find_if(m_customers.begin(), m_customers.end(),
-        [id](const Customer& c) {
-            return c.getId() == id;
-        });
-
-    if (it != m_customers.end()) {
-        return &(*it);
+    auto it = m_index.find(id);
+    if (it != m_index.end()) {
+        return m_customers.get(it->second);
     }
     return nullptr;
 }
@@ -39,9 +36,12 @@ bool CustomerController::add(const Customer& customer) {
     }
 
     // Update ID generator
-    IdGenerator::getInstance().updateCounter("customer", customer.getId());
+    IdGenerator::getInstance().updateCounter(EntityType::Customer, customer.getId());
 
-    m_customers.push_back(customer);
+    m_index[customer.getId()] = m_customers.insert(customer);
+    indexPhone(customer);
+    m_nameIndex.insert(customer.getId(), customer.getName());
+    m_table.markChanged(customer.getId());
     return true;
 }
 
@@ -51,54 +51,184 @@ bool CustomerController::update(const Customer& customer) {
         return false;
     }
 
-    existing->setName(customer.getName());
-    existing->setPhone(customer.getPhone());
-    existing->setLoyaltyPoints(customer.getLoyaltyPoints());
+    if (existing->getPhone() != customer.getPhone()) {
+        unindexPhone(*existing);
+        existing->setPhone(customer.getPhone());
+        indexPhone(*existing);
+    }
 
+    if (existing->getName() != customer.getName()) {
+        existing->setName(customer.getName());
+        m_nameIndex.insert(existing->getId(), existing->getName());
+    }
+
+    // Points are left alone: the caller's copy may be stale, and balances
+    // only change through the points operations below
+    m_table.markChanged(existing->getId());
     return true;
 }
 
 bool CustomerController::remove(int id) {
-    auto it = std::find_if(m_customers.begin(), m_customers.end(),
-        [id](const Customer& c) {
-            return c.getId() == id;
-        });
+    auto it = m_index.find(id);
+    if (it == m_index.end()) {
+        return false;
+    }
+
+    unindexPhone(*m_customers.get(it->second));
+    m_nameIndex.erase(id);
+    m_customers.erase(it->second);
+    m_index.erase(it);
+    m_table.markRemoved(id);
+    return true;
+}
+
+void CustomerController::indexPhone(const Customer& customer) {
+    std::string phone = normalizePhone(customer.getPhone());
+    if (phone.empty()) {
+        return;
+    }
+
+    m_phoneIndex.emplace(phone, customer.getId());
+    m_phoneTrie.insert(phone, customer.getId());
+}
+
+void CustomerController::unindexPhone(const Customer& customer) {
+    std::string phone = normalizePhone(customer.getPhone());
+    if (phone.empty()) {
+        return;
+    }
 
-    if (it != m_customers.end()) {
-        m_customers.erase(it);
-        return true;
+    auto range = m_phoneIndex.equal_range(phone);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == customer.getId()) {
+            m_phoneIndex.erase(it);
+            break;
+        }
     }
-    return false;
+    m_phoneTrie.erase(phone, customer.getId());
+}
+
+SlotHandle CustomerController::getHandle(int id) const {
+    auto it = m_index.find(id);
+    return (it != m_index.end()) ? it->second : SlotHandle();
+}
+
+Customer* CustomerController::get(SlotHandle handle) {
+    return m_customers.get(handle);
 }
 
 bool CustomerController::saveToFile() {
-    std::vector<std::string> lines;
-    lines.reserve(m_customers.size());
+    return m_table.save(m_customers.size(), [this](std::string& data) { writeRows(data); });
+}
+
+PendingFile CustomerController::snapshot() const {
+    return m_table.snapshot(m_customers.size(), [this](std::string& data) { writeRows(data); });
+}
 
+void CustomerController::writeRows(std::string& data) const {
     for (const auto& customer : m_customers) {
-        lines.push_back(customer.serialize());
+        // Checkout threads may be changing this balance
+        std::lock_guard<std::mutex> lock(pointLock(customer.getId()));
+        customer.serializeTo(data);
+        data += '\n';
     }
+}
 
-    return m_fileManager.writeLines(FILENAME, lines);
+bool CustomerController::hasUnsavedChanges() const {
+    return m_table.hasChanges();
 }
 
-bool CustomerController::loadFromFile() {
+std::vector<PendingFile> CustomerController::snapshotChanges() {
+    return m_table.snapshotChanges(
+        m_customers.size(), [this](std::string& data) { writeRows(data); },
+        [this](int id, std::string& payload) {
+            auto it = m_index.find(id);
+            if (it == m_index.end()) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(pointLock(id));
+            m_customers.get(it->second)->serializeTo(payload);
+            return true;
+        });
+}
+
+void CustomerController::requireFullSave() {
+    m_table.requireFullSave();
+}
+
+void CustomerController::writeImage(BinaryWriter& writer) const {
+    writer.put(static_cast<std::uint32_t>(m_customers.size()));
+    for (const auto& customer : m_customers) {
+        std::lock_guard<std::mutex> lock(pointLock(customer.getId()));
+        customer.writeBinary(writer);
+    }
+    writer.put(static_cast<std::uint64_t>(m_table.getJournalRecords()));
+}
+
+bool CustomerController::readImage(BinaryReader& reader) {
     m_customers.clear();
+    m_index.clear();
+    m_phoneIndex.clear();
+    m_phoneTrie.clear();
+    m_nameIndex.clear();
+
+    std::uint32_t count = reader.get<std::uint32_t>();
+    m_customers.reserve(count);
+    m_index.reserve(count);
+
+    for (std::uint32_t i = 0; i < count && reader.ok(); ++i) {
+        Customer customer;
+        if (!customer.readBinary(reader) || m_index.count(customer.getId()) > 0) {
+            return false;
+        }
+
+        IdGenerator::getInstance().updateCounter(EntityType::Customer, customer.getId());
+        m_index[customer.getId()] = m_customers.insert(customer);
+        indexPhone(customer);
+        m_nameIndex.insert(customer.getId(), customer.getName());
+    }
 
-    std::vector<std::string> lines = m_fileManager.readLines(FILENAME);
+    m_table.restore(static_cast<std::size_t>(reader.get<std::uint64_t>()));
+    return reader.ok();
+}
+
+void CustomerController::applyRecord(const std::string& record) {
+    Customer customer;
+    customer.deserialize(record);
+    if (!customer.isValid()) {
+        return;
+    }
+    if (update(customer)) {
+        restoreLoyaltyPoints(customer);
+    } else {
+        add(customer);
+    }
+}
+
+bool CustomerController::loadFromFile() {
+    m_customers.clear();
+    m_index.clear();
+    m_phoneIndex.clear();
+    m_phoneTrie.clear();
+    m_nameIndex.clear();
 
-    for (const auto& line : lines) {
-        if (line.empty()) continue;
+    MappedFile file = m_table.open();
 
+    for (std::string_view line : file) {
         Customer customer;
         customer.deserialize(line);
 
-        if (customer.isValid()) {
-            IdGenerator::getInstance().updateCounter("customer", customer.getId());
-            m_customers.push_back(customer);
+        if (customer.isValid() && m_index.count(customer.getId()) == 0) {
+            IdGenerator::getInstance().updateCounter(EntityType::Customer, customer.getId());
+            m_index[customer.getId()] = m_customers.insert(customer);
+            indexPhone(customer);
+            m_nameIndex.insert(customer.getId(), customer.getName());
         }
     }
 
+    // Changes saved since customers.txt was last rewritten
+    m_table.replay([this](const std::string& record) { applyRecord(record); },
+                   [this](int id) { remove(id); });
     return true;
 }
 
@@ -107,39 +237,77 @@ int CustomerController::getCount() const {
 }
 
 Customer CustomerController::createCustomer(const std::string& name, const std::string& phone) {
-    int id = IdGenerator::getInstance().getNextId("customer");
+    int id = IdGenerator::getInstance().getNextId(EntityType::Customer);
     return Customer(id, name, phone, 0);
 }
 
-std::vector<Customer*> CustomerController::searchByName(const std::string& searchTerm) {
+std::vector<Customer*> CustomerController::searchByName(const std::string& searchTerm,
+                                                        std::size_t limit) {
     std::vector<Customer*> results;
 
-    // Convert search term to lowercase for case-insensitive search
-    std::string lowerSearch = searchTerm;
-    std::transform(lowerSearch.begin(), lowerSearch.end(), lowerSearch.begin(), ::tolower);
+    for (int id : m_nameIndex.search(searchTerm, limit)) {
+        if (Customer* customer = getById(id)) {
+            results.push_back(customer);
+        }
+    }
 
-    for (auto& customer : m_customers) {
-        std::string lowerName = customer.getName();
-        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+    return results;
+}
 
-        if (lowerName.find(lowerSearch) != std::string::npos) {
-            results.push_back(&customer);
+Customer* CustomerController::getByPhone(const std::string& phone) {
+    auto it = m_phoneIndex.find(normalizePhone(phone));
+    if (it != m_phoneIndex.end()) {
+        return getById(it->second);
+    }
+    return nullptr;
+}
+
+std::vector<Customer*> CustomerController::searchByPhonePrefix(const std::string& prefix,
+                                                               std::size_t limit) {
+    std::vector<Customer*> results;
+
+    std::string digits = normalizePhone(prefix);
+    if (digits.empty()) {
+        return results;
+    }
+
+    for (int id : m_phoneTrie.findByPrefix(digits, limit)) {
+        if (Customer* customer = getById(id)) {
+            results.push_back(customer);
         }
     }
 
     return results;
 }
 
-Customer* CustomerController::getByPhone(const std::string& phone) {
-    auto it = std::find_if(m_customers.begin(), m_customers.end(),
-        [&phone](const Customer& c) {
-            return c.getPhone() == phone;
-        });
+std::string CustomerController::normalizePhone(std::string_view phone) {
+    std::string digits;
+    digits.reserve(phone.size());
 
-    if (it != m_customers.end()) {
-        return &(*it);
+    for (char c : phone) {
+        if (c >= '0' && c <= '9') {
+            digits += c;
+        }
     }
-    return nullptr;
+
+    // +62 812... and 0812... are the same number
+    if (digits.size() > 2 && digits[0] == '6' && digits[1] == '2') {
+        digits.replace(0, 2, "0");
+    }
+
+    return digits;
+}
+
+void CustomerController::restoreLoyaltyPoints(const Customer& customer) {
+    Customer* existing = getById(customer.getId());
+    if (existing) {
+        std::lock_guard<std::mutex> lock(pointLock(customer.getId()));
+        existing->restorePoints(customer.getLoyaltyPoints(), customer.getVersion());
+    }
+}
+
+std::mutex& CustomerController::pointLock(int customerId) const {
+    return m_pointLocks[static_cast<std::size_t>(customerId) % POINT_LOCK_STRIPES];
 }
 
 bool CustomerController::addLoyaltyPoints(int customerId, int points) {
@@ -148,7 +316,9 @@ bool CustomerController::addLoyaltyPoints(int customerId, int points) {
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(pointLock(customerId));
     customer->addPoints(points);
+    m_table.markChanged(customerId);
     return true;
 }
 
@@ -158,17 +328,73 @@ bool CustomerController::redeemLoyaltyPoints(int customerId, int points) {
         return false;
     }
 
-    return customer->redeemPoints(points);
+    std::lock_guard<std::mutex> lock(pointLock(customerId));
+    if (!customer->redeemPoints(points)) {
+        return false;
+    }
+
+    m_table.markChanged(customerId);
+    return true;
 }
 
 int CustomerController::getLoyaltyPoints(int customerId) const {
-    auto it = std::find_if(m_customers.begin(), m_customers.end(),
-        [customerId](const Customer& c) {
-            return c.getId() == customerId;
-        });
-
-    if (it != m_customers.end()) {
-        return it->getLoyaltyPoints();
+    auto it = m_index.find(customerId);
+    if (it != m_index.end()) {
+        std::lock_guard<std::mutex> lock(pointLock(customerId));
+        return m_customers.get(it->second)->getLoyaltyPoints();
     }
     return -1;
 }
+
+bool CustomerController::readLoyaltyPoints(int customerId, int& points,
+                                           std::uint32_t& version) const {
+    auto it = m_index.find(customerId);
+    if (it == m_index.end()) {
+        return false;
+    }
+
+    const Customer* customer = m_customers.get(it->second);
+    std::lock_guard<std::mutex> lock(pointLock(customerId));
+    points = customer->getLoyaltyPoints();
+    version = customer->getVersion();
+    return true;
+}
+
+bool CustomerController::compareAndSetLoyaltyPoints(int customerId, std::uint32_t& version,
+                                                    int points) {
+    return commitLoyaltyPoints(customerId, version, points, [](std::uint32_t) { return true; });
+}
+
+bool CustomerController::commitLoyaltyPoints(int customerId, std::uint32_t& version, int points,
+                                             const std::function<bool(std::uint32_t)>& persist) {
+    Customer* customer = getById(customerId);
+    if (!customer || points < 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(pointLock(customerId));
+    if (customer->getVersion() != version || !persist(version + 1)) {
+        return false;
+    }
+
+    customer->commitPoints(points);
+    version = customer->getVersion();
+    m_table.markChanged(customerId);
+    return true;
+}
+
+bool CustomerController::replayLoyaltyPoints(int customerId, int points, std::uint32_t version) {
+    Customer* customer = getById(customerId);
+    if (!customer || points < 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(pointLock(customerId));
+    if (customer->getVersion() >= version) {
+        return false;
+    }
+
+    customer->restorePoints(points, version);
+    m_table.markChanged(customerId);
+    return true;
+}
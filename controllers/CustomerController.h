@@ -13,17 +13,85 @@
 #include "IController.h"
 #include "../models/Customer.h"
 #include "../utils/FileManager.h"
+#include "../utils/BackgroundWriter.h"
+#include "../utils/JournaledTable.h"
+#include "../utils/BinaryIO.h"
+#include "../utils/SlotMap.h"
+#include "../utils/DigitTrie.h"
+#include "../utils/NgramIndex.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 /**
  * @class CustomerController
  * @brief Manages customer CRUD operations and loyalty points
+ *
+ * Point balances may be changed from several checkout threads at once.
+ * Each balance is guarded by one of a fixed set of striped locks, chosen
+ * by customer ID, so tills serving different customers rarely contend.
+ * The table itself (adding or removing customers) is not locked and must
+ * only change while no checkout is in progress. update() edits name and
+ * phone only; balances change solely through the points operations.
+ *
+ * Saves are incremental: customers changed since the last save are
+ * appended to customers.log, and customers.txt is only rewritten once
+ * that journal grows as large as the table itself.
  */
 class CustomerController : public IController<Customer> {
 private:
-    std::vector<Customer> m_customers;  ///< Customer collection
-    FileManager& m_fileManager;          ///< File I/O handler
+    SlotMap<Customer> m_customers;                  ///< Customer collection
+    std::unordered_map<int, SlotHandle> m_index;    ///< Customer ID -> handle in m_customers
+    std::unordered_multimap<std::string, int> m_phoneIndex;  ///< Normalized phone -> customer ID
+    DigitTrie m_phoneTrie;                          ///< Normalized phone prefixes -> customer ID
+    NgramIndex m_nameIndex;                         ///< Name trigrams -> customer ID
+    FileManager& m_fileManager;                     ///< File I/O handler
     static constexpr const char* FILENAME = "customers.txt";
+    static constexpr const char* JOURNAL_FILENAME = "customers.log";
+    static constexpr std::size_t RECORD_SIZE_HINT = 48;  ///< Typical serialized record length
+    JournaledTable m_table;                         ///< Customers changed since the last save and where they go
+    static constexpr std::size_t POINT_LOCK_STRIPES = 16;  ///< Number of point-balance locks
+    mutable std::array<std::mutex, POINT_LOCK_STRIPES> m_pointLocks;  ///< Point-balance locks by ID
+
+    /**
+     * @brief Gets the lock guarding a customer's points
+     * @param customerId Customer ID
+     * @return Stripe lock for that customer
+     */
+    std::mutex& pointLock(int customerId) const;
+
+    /**
+     * @brief Sets a customer's balance from a journal record
+     * @param customer Record read back from customers.log
+     */
+    void restoreLoyaltyPoints(const Customer& customer);
+
+    /**
+     * @brief Adds a customer's phone to the phone indexes
+     * @param customer Customer to index
+     */
+    void indexPhone(const Customer& customer);
+
+    /**
+     * @brief Removes a customer's phone from the phone indexes
+     * @param customer Customer to unindex
+     */
+    void unindexPhone(const Customer& customer);
+
+    /**
+     * @brief Appends every customer to a customers.txt buffer
+     * @param data Buffer to append to
+     */
+    void writeRows(std::string& data) const;
+
+    /**
+     * @brief Adds or replaces a customer from a customers.log record
+     * @param record Serialized customer
+     */
+    void applyRecord(const std::string& record);
 
 public:
     /**
@@ -48,6 +116,70 @@ public:
     bool loadFromFile() override;
     int getCount() const override;
 
+    /**
+     * @brief Serializes all customers for a background save
+     * @return Customers file content, ready for BackgroundWriter
+     */
+    PendingFile snapshot() const;
+
+    // ============ Incremental Saves ============
+
+    /**
+     * @brief Checks whether any customer changed since the last save
+     * @return true if there is something to save
+     */
+    bool hasUnsavedChanges() const;
+
+    /**
+     * @brief Serializes only what changed since the last save
+     * @return Files for BackgroundWriter: nothing, a journal append, or
+     *         (when the journal is due for compaction) a full rewrite
+     *         under a new generation followed by an emptied journal
+     */
+    std::vector<PendingFile> snapshotChanges();
+
+    /**
+     * @brief Makes the next snapshotChanges() rewrite everything
+     *
+     * Call when a save failed, since its changes were already taken.
+     */
+    void requireFullSave();
+
+    // ============ Binary Image ============
+
+    /**
+     * @brief Appends all customers to a state image payload
+     * @param writer Binary writer
+     */
+    void writeImage(BinaryWriter& writer) const;
+
+    /**
+     * @brief Replaces all customers with a section written by writeImage()
+     * @param reader Binary reader
+     * @return true if the section was complete (state is undefined otherwise;
+     *         fall back to loadFromFile())
+     */
+    bool readImage(BinaryReader& reader);
+
+    // ============ Stable Handles ============
+
+    /**
+     * @brief Gets a stable handle for a customer
+     * @param id Customer ID
+     * @return Handle that survives other inserts/removes (null if not found)
+     *
+     * Pointers from getById() are only valid until the next add() or
+     * remove(); keep a handle instead when holding on to a customer.
+     */
+    SlotHandle getHandle(int id) const;
+
+    /**
+     * @brief Resolves a handle to its customer
+     * @param handle Handle from getHandle()
+     * @return Pointer to customer, nullptr if it has since been removed
+     */
+    Customer* get(SlotHandle handle);
+
     // ============ Customer-Specific Methods ============
 
     /**
@@ -59,19 +191,35 @@ public:
     Customer createCustomer(const std::string& name, const std::string& phone);
 
     /**
-     * @brief Searches customers by name (partial match)
+     * @brief Searches customers by name (partial match, case-insensitive)
      * @param searchTerm Search term
-     * @return Vector of matching customers
+     * @param limit Maximum number of results (0 for no limit)
+     * @return Matching customers, best matches first (see NgramIndex::search)
      */
-    std::vector<Customer*> searchByName(const std::string& searchTerm);
+    std::vector<Customer*> searchByName(const std::string& searchTerm, std::size_t limit = 0);
 
     /**
      * @brief Gets customer by phone number
-     * @param phone Phone number to search
+     * @param phone Phone number to search (any formatting, see normalizePhone)
      * @return Pointer to customer, nullptr if not found
      */
     Customer* getByPhone(const std::string& phone);
 
+    /**
+     * @brief Finds customers whose phone starts with the typed digits
+     * @param prefix Digits typed so far (any formatting, see normalizePhone)
+     * @param limit Maximum number of results
+     * @return Matching customers ordered by phone number
+     */
+    std::vector<Customer*> searchByPhonePrefix(const std::string& prefix, std::size_t limit = 20);
+
+    /**
+     * @brief Normalizes a phone number for indexing
+     * @param phone Phone number as entered
+     * @return Digits only, with a leading country code 62 folded to 0
+     */
+    static std::string normalizePhone(std::string_view phone);
+
     // ============ Loyalty Points Operations ============
 
     /**
@@ -96,6 +244,57 @@ public:
      * @return Points balance, -1 if customer not found
      */
     int getLoyaltyPoints(int customerId) const;
+
+    /**
+     * @brief Reads a points balance together with its version
+     * @param customerId Customer ID
+     * @param points Receives the balance
+     * @param version Receives the version to pass to compareAndSetLoyaltyPoints()
+     * @return true if the customer exists
+     */
+    bool readLoyaltyPoints(int customerId, int& points, std::uint32_t& version) const;
+
+    /**
+     * @brief Sets a points balance only if it has not changed since it was read
+     * @param customerId Customer ID
+     * @param version Version returned by readLoyaltyPoints(); receives the
+     *        balance's new version when set
+     * @param points New balance
+     * @return true if set; false if the customer is gone or the version moved on
+     *
+     * A successful set always takes a new version, even when the balance
+     * is unchanged.
+     */
+    bool compareAndSetLoyaltyPoints(int customerId, std::uint32_t& version, int points);
+
+    /**
+     * @brief Sets a points balance only if unchanged and made durable first
+     * @param customerId Customer ID
+     * @param version As for compareAndSetLoyaltyPoints()
+     * @param points New balance
+     * @param persist Called with the version the balance will take, while
+     *        no other write to it can land; return false to abandon the set
+     * @return true if set; false if the customer is gone, the version moved
+     *         on, or persist failed
+     *
+     * Lets a sale log the new balance before anyone can see it, so a sale
+     * that fails to log never leaves a balance to be taken back. persist
+     * runs under the balance's lock and must not touch points itself.
+     */
+    bool commitLoyaltyPoints(int customerId, std::uint32_t& version, int points,
+                             const std::function<bool(std::uint32_t)>& persist);
+
+    /**
+     * @brief Applies a balance logged with a sale, unless the stored one is as new
+     * @param customerId Customer ID
+     * @param points Balance after the sale
+     * @param version Points version after the sale
+     * @return true if the stored balance was older and has been replaced
+     *
+     * Used by transaction log replay: a sale's points reach customers.txt
+     * only at the next save, so after a crash the log is the newer copy.
+     */
+    bool replayLoyaltyPoints(int customerId, int points, std::uint32_t version);
 };
 
 #endif // CUSTOMERCONTROLLER_H
@@ -4,63 +4,134 @@
  */
 
 #include "ProductController.h"
-#include "../models/Coffee.h"
-#include "../models/Snack.h"
 #include "../utils/IdGenerator.h"
 #include <algorithm>
+#include <type_traits>
+
+// Partitions are indexed by variant index, so both must list types in the same order
+static_assert(std::variant_size_v<ProductVariant> == PRODUCT_TYPE_COUNT,
+              "ProductVariant must have one alternative per ProductType");
+static_assert(std::is_same_v<std::variant_alternative_t<
+                  static_cast<std::size_t>(ProductType::Coffee), ProductVariant>, Coffee> &&
+              std::is_same_v<std::variant_alternative_t<
+                  static_cast<std::size_t>(ProductType::Snack), ProductVariant>, Snack>,
+              "ProductVariant alternatives must follow ProductType order");
 
 ProductController::ProductController(FileManager& fileManager)
     : m_fileManager(fileManager)
+    , m_table(fileManager, FILENAME, JOURNAL_FILENAME, RECORD_SIZE_HINT)
 {
 }
 
-std::vector<Product*> ProductController::getAll() const {
+Product& ProductController::asProduct(ProductVariant& product) {
+    return std::visit([](auto& concrete) -> Product& { return concrete; }, product);
+}
+
+const Product& ProductController::asProduct(const ProductVariant& product) {
+    return std::visit([](const auto& concrete) -> const Product& { return concrete; }, product);
+}
+
+std::vector<Product*> ProductController::getAll() {
     std::vector<Product*> result;
     result.reserve(m_products.size());
+    for (auto& product : m_products) {
+        result.push_back(&asProduct(product));
+    }
+    return result;
+}
 
+std::vector<const Product*> ProductController::getAll() const {
+    std::vector<const Product*> result;
+    result.reserve(m_products.size());
     for (const auto& product : m_products) {
-        result.push_back(product.get());
+        result.push_back(&asProduct(product));
     }
-
     return result;
 }
 
 Product* ProductController::getById(int id) {
-    auto it = std::find_if(m_products.begin(), m_products.end(),
-        [id](const std::unique_ptr<Product>& p) {
-            return p->getId() == id;
-        });
+    auto it = m_index.find(id);
+    if (it != m_index.end()) {
+        return &asProduct(m_products[it->second]);
+    }
+    return nullptr;
+}
 
-    if (it != m_products.end()) {
-        return it->get();
+const Product* ProductController::getById(int id) const {
+    auto it = m_index.find(id);
+    if (it != m_index.end()) {
+        return &asProduct(m_products[it->second]);
     }
     return nullptr;
 }
 
-std::vector<Product*> ProductController::getByType(const std::string& type) const {
-    std::vector<Product*> result;
+ProductController::TypeRange<Product> ProductController::getByType(const std::string& type) {
+    ProductType tag;
+    if (!Product::parseType(type, tag)) {
+        return {};
+    }
+    return getByType(tag);
+}
 
-    for (const auto& product : m_products) {
-        if (product->getType() == type) {
-            result.push_back(product.get());
-        }
+ProductController::TypeRange<const Product> ProductController::getByType(const std::string& type) const {
+    ProductType tag;
+    if (!Product::parseType(type, tag)) {
+        return {};
     }
+    return getByType(tag);
+}
 
-    return result;
+ProductController::TypeRange<Product> ProductController::getByType(ProductType type) {
+    return TypeRange<Product>(m_products, m_byType[static_cast<std::size_t>(type)]);
+}
+
+ProductController::TypeRange<const Product> ProductController::getByType(ProductType type) const {
+    return TypeRange<const Product>(m_products, m_byType[static_cast<std::size_t>(type)]);
+}
+
+const std::vector<ProductVariant>& ProductController::getCatalog() const {
+    return m_products;
 }
 
 bool ProductController::add(std::unique_ptr<Product> product) {
-    if (!product || !product->isValid()) {
+    if (!product) {
+        return false;
+    }
+
+    if (product->getProductType() == ProductType::Coffee) {
+        return add(ProductVariant(std::in_place_type<Coffee>,
+                                  std::move(static_cast<Coffee&>(*product))));
+    }
+    return add(ProductVariant(std::in_place_type<Snack>,
+                              std::move(static_cast<Snack&>(*product))));
+}
+
+bool ProductController::add(ProductVariant product) {
+    const Product& base = asProduct(product);
+    if (!base.isValid()) {
+        return false;
+    }
+
+    // Check for duplicate ID
+    if (m_index.count(base.getId()) > 0) {
         return false;
     }
 
     // Update ID generator with this ID
-    IdGenerator::getInstance().updateCounter("product", product->getId());
+    IdGenerator::getInstance().updateCounter(EntityType::Product, base.getId());
 
-    m_products.push_back(std::move(product));
+    m_table.markChanged(base.getId());
+    store(std::move(product));
     return true;
 }
 
+void ProductController::store(ProductVariant&& product) {
+    std::size_t position = m_products.size();
+    m_index[asProduct(product).getId()] = position;
+    m_byType[product.index()].push_back(position);
+    m_products.push_back(std::move(product));
+}
+
 bool ProductController::update(const Product& product) {
     Product* existing = getById(product.getId());
     if (!existing) {
@@ -71,78 +142,186 @@ bool ProductController::update(const Product& product) {
     existing->setPrice(product.getPrice());
     existing->setExtraField(product.getExtraField());
 
+    m_table.markChanged(existing->getId());
     return true;
 }
 
 bool ProductController::remove(int id) {
-    auto it = std::find_if(m_products.begin(), m_products.end(),
-        [id](const std::unique_ptr<Product>& p) {
-            return p->getId() == id;
-        });
+    auto it = m_index.find(id);
+    if (it == m_index.end()) {
+        return false;
+    }
 
-    if (it != m_products.end()) {
-        m_products.erase(it);
-        return true;
+    std::size_t position = it->second;
+    std::vector<std::size_t>& partition = m_byType[m_products[position].index()];
+    partition.erase(std::find(partition.begin(), partition.end(), position));
+
+    m_index.erase(it);
+    m_products.erase(m_products.begin() + static_cast<std::ptrdiff_t>(position));
+    reindexFrom(position);
+    m_table.markRemoved(id);
+    return true;
+}
+
+void ProductController::reindexFrom(std::size_t position) {
+    for (std::size_t i = position; i < m_products.size(); ++i) {
+        m_index[asProduct(m_products[i]).getId()] = i;
+    }
+
+    for (auto& partition : m_byType) {
+        for (std::size_t& entry : partition) {
+            if (entry > position) {
+                --entry;
+            }
+        }
     }
-    return false;
 }
 
-std::unique_ptr<Product> ProductController::createCoffee(const std::string& name, double price,
+std::unique_ptr<Product> ProductController::createCoffee(const std::string& name, Money price,
                                                           const std::string& shotSize) {
-    int id = IdGenerator::getInstance().getNextId("product");
+    int id = IdGenerator::getInstance().getNextId(EntityType::Product);
     return std::make_unique<Coffee>(id, name, price, shotSize);
 }
 
-std::unique_ptr<Product> ProductController::createSnack(const std::string& name, double price,
+std::unique_ptr<Product> ProductController::createSnack(const std::string& name, Money price,
                                                          const std::string& category) {
-    int id = IdGenerator::getInstance().getNextId("product");
+    int id = IdGenerator::getInstance().getNextId(EntityType::Product);
     return std::make_unique<Snack>(id, name, price, category);
 }
 
 bool ProductController::saveToFile() {
-    std::vector<std::string> lines;
-    lines.reserve(m_products.size());
+    return m_table.save(m_products.size(), [this](std::string& data) { writeRows(data); });
+}
 
+PendingFile ProductController::snapshot() const {
+    return m_table.snapshot(m_products.size(), [this](std::string& data) { writeRows(data); });
+}
+
+void ProductController::writeRows(std::string& data) const {
     for (const auto& product : m_products) {
-        lines.push_back(product->serialize());
+        asProduct(product).serializeTo(data);
+        data += '\n';
     }
-
-    return m_fileManager.writeLines(FILENAME, lines);
 }
 
 bool ProductController::loadFromFile() {
     m_products.clear();
+    m_index.clear();
+    for (auto& partition : m_byType) {
+        partition.clear();
+    }
 
-    std::vector<std::string> lines = m_fileManager.readLines(FILENAME);
+    MappedFile file = m_table.open();
 
-    for (const auto& line : lines) {
-        if (line.empty()) continue;
+    for (std::string_view line : file) {
+        ProductVariant product;
+        if (!parseRecord(line, product)) {
+            continue;
+        }
 
-        // Parse type from the line to determine product type
-        std::vector<std::string> fields = FileManager::splitLine(line, '|');
-        if (fields.size() < 4) continue;
+        int id = asProduct(product).getId();
+        if (m_index.count(id) == 0) {
+            // Update ID generator
+            IdGenerator::getInstance().updateCounter(EntityType::Product, id);
+            store(std::move(product));
+        }
+    }
 
-        std::string type = fields[3];
-        std::unique_ptr<Product> product;
+    // Changes saved since products.txt was last rewritten
+    m_table.replay([this](const std::string& record) { applyRecord(record); },
+                   [this](int id) { remove(id); });
+    return true;
+}
 
-        if (type == "coffee") {
-            product = std::make_unique<Coffee>();
-        } else if (type == "snack") {
-            product = std::make_unique<Snack>();
-        } else {
-            continue;  // Unknown type
-        }
+bool ProductController::parseRecord(std::string_view line, ProductVariant& product) {
+    // Parse type from the line to determine product type
+    std::string_view fields[4];
+    if (FileManager::splitFields(line, '|', fields, 4) < 4) {
+        return false;
+    }
 
-        product->deserialize(line);
+    ProductType type;
+    if (!Product::parseType(fields[3], type)) {
+        return false;  // Unknown type
+    }
 
-        if (product->isValid()) {
-            // Update ID generator
-            IdGenerator::getInstance().updateCounter("product", product->getId());
-            m_products.push_back(std::move(product));
+    if (type == ProductType::Snack) {
+        product.emplace<Snack>();
+    } else {
+        product.emplace<Coffee>();
+    }
+
+    Product& base = asProduct(product);
+    base.deserialize(line);
+    return base.isValid();
+}
+
+void ProductController::applyRecord(const std::string& record) {
+    ProductVariant product;
+    if (parseRecord(record, product) && !update(asProduct(product))) {
+        add(std::move(product));
+    }
+}
+
+bool ProductController::hasUnsavedChanges() const {
+    return m_table.hasChanges();
+}
+
+std::vector<PendingFile> ProductController::snapshotChanges() {
+    return m_table.snapshotChanges(
+        m_products.size(), [this](std::string& data) { writeRows(data); },
+        [this](int id, std::string& payload) {
+            auto it = m_index.find(id);
+            if (it == m_index.end()) {
+                return false;
+            }
+            asProduct(m_products[it->second]).serializeTo(payload);
+            return true;
+        });
+}
+
+void ProductController::requireFullSave() {
+    m_table.requireFullSave();
+}
+
+void ProductController::writeImage(BinaryWriter& writer) const {
+    writer.put(static_cast<std::uint32_t>(m_products.size()));
+    for (const auto& product : m_products) {
+        const Product& base = asProduct(product);
+        writer.put(static_cast<std::uint8_t>(base.getProductType()));
+        base.writeBinary(writer);
+    }
+    writer.put(static_cast<std::uint64_t>(m_table.getJournalRecords()));
+}
+
+bool ProductController::readImage(BinaryReader& reader) {
+    m_products.clear();
+    m_index.clear();
+    for (auto& partition : m_byType) {
+        partition.clear();
+    }
+
+    std::uint32_t count = reader.get<std::uint32_t>();
+    for (std::uint32_t i = 0; i < count && reader.ok(); ++i) {
+        std::uint8_t type = reader.get<std::uint8_t>();
+        ProductVariant product;
+        if (type == static_cast<std::uint8_t>(ProductType::Snack)) {
+            product.emplace<Snack>();
+        } else if (type != static_cast<std::uint8_t>(ProductType::Coffee)) {
+            return false;
         }
+
+        Product& base = asProduct(product);
+        if (!base.readBinary(reader) || m_index.count(base.getId()) > 0) {
+            return false;
+        }
+
+        IdGenerator::getInstance().updateCounter(EntityType::Product, base.getId());
+        store(std::move(product));
     }
 
-    return true;
+    m_table.restore(static_cast<std::size_t>(reader.get<std::uint64_t>()));
+    return reader.ok();
 }
 
 int ProductController::getCount() const {
@@ -150,8 +329,10 @@ int ProductController::getCount() const {
 }
 
 int ProductController::getCountByType(const std::string& type) const {
-    return static_cast<int>(std::count_if(m_products.begin(), m_products.end(),
-        [&type](const std::unique_ptr<Product>& p) {
-            return p->getType() == type;
-        }));
+    ProductType tag;
+    return Product::parseType(type, tag) ? getCountByType(tag) : 0;
+}
+
+int ProductController::getCountByType(ProductType type) const {
+    return static_cast<int>(m_byType[static_cast<std::size_t>(type)].size());
 }
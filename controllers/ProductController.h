@@ -13,24 +13,161 @@
 
 #include "IController.h"
 #include "../models/Product.h"
+#include "../models/Coffee.h"
+#include "../models/Snack.h"
 #include "../utils/FileManager.h"
+#include "../utils/BackgroundWriter.h"
+#include "../utils/JournaledTable.h"
+#include "../utils/BinaryIO.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
 #include <vector>
 
+/**
+ * @brief A product stored by value; the alternative order matches ProductType
+ */
+using ProductVariant = std::variant<Coffee, Snack>;
+
 /**
  * @class ProductController
  * @brief Manages product CRUD operations and persistence
  *
- * This controller handles both Coffee and Snack products using
- * polymorphism. Products are stored as unique_ptr for memory safety.
+ * This controller handles both Coffee and Snack products. Products are
+ * stored by value in one contiguous vector of variants instead of one heap
+ * object each; internal code reaches them through std::visit, where Coffee
+ * and Snack being final lets the compiler call their methods directly.
+ * Each type also has its own partition, so listing or counting one type
+ * never looks at products of the other.
+ *
+ * Product pointers and type ranges returned by this class stay valid until
+ * the next add, remove or loadFromFile. Edits must go through update() so that they are
+ * picked up by the next incremental save (see snapshotChanges()).
  */
 class ProductController {
 private:
-    std::vector<std::unique_ptr<Product>> m_products;  ///< Product collection
+    std::vector<ProductVariant> m_products;        ///< Product collection, in catalog order
+    std::unordered_map<int, std::size_t> m_index;  ///< Product ID -> position in m_products
+    std::array<std::vector<std::size_t>, PRODUCT_TYPE_COUNT> m_byType;  ///< Positions of each type, in catalog order
     FileManager& m_fileManager;                         ///< File I/O handler
     static constexpr const char* FILENAME = "products.txt";
+    static constexpr const char* JOURNAL_FILENAME = "products.log";
+    static constexpr std::size_t RECORD_SIZE_HINT = 48;  ///< Typical serialized record length
+    JournaledTable m_table;                              ///< Products changed since the last save and where they go
+
+    /**
+     * @brief Re-points index entries for products at or after a position
+     * @param position First position whose entry may be stale
+     */
+    void reindexFrom(std::size_t position);
+
+    /**
+     * @brief Appends a product to the catalog and indexes it
+     * @param product Product to store (ID must not be present)
+     */
+    void store(ProductVariant&& product);
+
+    /**
+     * @brief Views a stored product through its base class
+     * @param product Stored product
+     * @return Reference to the Coffee or Snack inside
+     */
+    static Product& asProduct(ProductVariant& product);
+    static const Product& asProduct(const ProductVariant& product);
+
+    /**
+     * @brief Parses a product record into the right variant alternative
+     * @param line Serialized product
+     * @param product Receives the product
+     * @return true if the type was recognized and the product is valid
+     */
+    static bool parseRecord(std::string_view line, ProductVariant& product);
+
+    /**
+     * @brief Appends every product to a products.txt buffer
+     * @param data Buffer to append to
+     */
+    void writeRows(std::string& data) const;
+
+    /**
+     * @brief Adds or replaces a product from a products.log record
+     * @param record Serialized product
+     */
+    void applyRecord(const std::string& record);
 
 public:
+    /**
+     * @class TypeRange
+     * @brief The products of one type, read through that type's partition
+     *
+     * Copies nothing, so it is invalidated together with product pointers.
+     * Iterating yields Product*, or const Product* from a const controller.
+     */
+    template<typename Value>
+    class TypeRange {
+    private:
+        using Catalog = std::conditional_t<std::is_const_v<Value>,
+                                           const std::vector<ProductVariant>,
+                                           std::vector<ProductVariant>>;
+
+        Catalog* m_catalog;            ///< Stored products
+        const std::size_t* m_first;    ///< First position in the partition
+        const std::size_t* m_last;     ///< One past the last position
+
+    public:
+        /**
+         * @class Iterator
+         * @brief Input iterator yielding a pointer to each product
+         */
+        class Iterator {
+        private:
+            Catalog* m_catalog;                ///< Stored products
+            const std::size_t* m_position;     ///< Current entry of the partition
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Value*;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value* const*;
+            using reference = Value*;
+
+            Iterator(Catalog* catalog, const std::size_t* position)
+                : m_catalog(catalog), m_position(position) {}
+
+            Value* operator*() const { return &asProduct((*m_catalog)[*m_position]); }
+            Iterator& operator++() { ++m_position; return *this; }
+            Iterator operator++(int) { Iterator tmp = *this; ++m_position; return tmp; }
+
+            bool operator==(const Iterator& other) const { return m_position == other.m_position; }
+            bool operator!=(const Iterator& other) const { return !(*this == other); }
+        };
+
+        /**
+         * @brief Constructs an empty range
+         */
+        TypeRange() : m_catalog(nullptr), m_first(nullptr), m_last(nullptr) {}
+
+        /**
+         * @brief Constructs a range over a partition
+         * @param catalog Stored products
+         * @param positions Positions of the products in the range
+         */
+        TypeRange(Catalog& catalog, const std::vector<std::size_t>& positions)
+            : m_catalog(&catalog)
+            , m_first(positions.data())
+            , m_last(positions.data() + positions.size()) {}
+
+        Iterator begin() const { return Iterator(m_catalog, m_first); }
+        Iterator end() const { return Iterator(m_catalog, m_last); }
+        std::size_t size() const { return static_cast<std::size_t>(m_last - m_first); }
+        bool empty() const { return m_first == m_last; }
+    };
+
     /**
      * @brief Constructs controller with FileManager dependency
      * @param fileManager Reference to FileManager for I/O
@@ -46,9 +183,10 @@ public:
 
     /**
      * @brief Gets all products as raw pointers
-     * @return Vector of product pointers
+     * @return Vector of product pointers, in catalog order
      */
-    std::vector<Product*> getAll() const;
+    std::vector<Product*> getAll();
+    std::vector<const Product*> getAll() const;
 
     /**
      * @brief Gets a product by ID
@@ -56,13 +194,29 @@ public:
      * @return Pointer to product, nullptr if not found
      */
     Product* getById(int id);
+    const Product* getById(int id) const;
 
     /**
      * @brief Gets products by type
      * @param type "coffee" or "snack"
-     * @return Vector of matching products
+     * @return Matching products; empty if the type is unknown
      */
-    std::vector<Product*> getByType(const std::string& type) const;
+    TypeRange<Product> getByType(const std::string& type);
+    TypeRange<const Product> getByType(const std::string& type) const;
+
+    /**
+     * @brief Gets products by type without copying the partition
+     * @param type Product type
+     * @return Products of that type, in catalog order
+     */
+    TypeRange<Product> getByType(ProductType type);
+    TypeRange<const Product> getByType(ProductType type) const;
+
+    /**
+     * @brief Gets the stored products for statically dispatched iteration
+     * @return All products in catalog order (use std::visit on each)
+     */
+    const std::vector<ProductVariant>& getCatalog() const;
 
     /**
      * @brief Adds a new product (takes ownership)
@@ -71,6 +225,13 @@ public:
      */
     bool add(std::unique_ptr<Product> product);
 
+    /**
+     * @brief Adds a new product by value
+     * @param product Coffee or Snack to add
+     * @return true if successful
+     */
+    bool add(ProductVariant product);
+
     /**
      * @brief Updates an existing product
      * @param product Product with updated data
@@ -94,7 +255,7 @@ public:
      * @param shotSize Shot size (single/double)
      * @return Unique pointer to new Coffee
      */
-    std::unique_ptr<Product> createCoffee(const std::string& name, double price,
+    std::unique_ptr<Product> createCoffee(const std::string& name, Money price,
                                            const std::string& shotSize = "single");
 
     /**
@@ -104,7 +265,7 @@ public:
      * @param category Category (pastry/sandwich/other)
      * @return Unique pointer to new Snack
      */
-    std::unique_ptr<Product> createSnack(const std::string& name, double price,
+    std::unique_ptr<Product> createSnack(const std::string& name, Money price,
                                           const std::string& category = "other");
 
     // ============ File I/O ============
@@ -115,6 +276,47 @@ public:
      */
     bool saveToFile();
 
+    /**
+     * @brief Serializes all products for a background save
+     * @return Products file content, ready for BackgroundWriter
+     */
+    PendingFile snapshot() const;
+
+    /**
+     * @brief Checks whether any product changed since the last save
+     * @return true if there is something to save
+     */
+    bool hasUnsavedChanges() const;
+
+    /**
+     * @brief Serializes only what changed since the last save
+     * @return Files for BackgroundWriter: nothing, a products.log append,
+     *         or a full rewrite under a new generation followed by an
+     *         emptied journal
+     */
+    std::vector<PendingFile> snapshotChanges();
+
+    /**
+     * @brief Makes the next snapshotChanges() rewrite everything
+     */
+    void requireFullSave();
+
+    // ============ Binary Image ============
+
+    /**
+     * @brief Appends all products to a state image payload
+     * @param writer Binary writer
+     */
+    void writeImage(BinaryWriter& writer) const;
+
+    /**
+     * @brief Replaces all products with a section written by writeImage()
+     * @param reader Binary reader
+     * @return true if the section was complete (state is undefined otherwise;
+     *         fall back to loadFromFile())
+     */
+    bool readImage(BinaryReader& reader);
+
     /**
      * @brief Loads all products from file
      * @return true if successful
@@ -135,6 +337,13 @@ public:
      * @return Number of products of that type
      */
     int getCountByType(const std::string& type) const;
+
+    /**
+     * @brief Gets count by product type
+     * @param type Product type
+     * @return Number of products of that type
+     */
+    int getCountByType(ProductType type) const;
 };
 
 #endif // PRODUCTCONTROLLER_H
@@ -5,7 +5,9 @@
 
 #include "TransactionController.h"
 #include "../utils/IdGenerator.h"
+#include "../utils/DateTime.h"
 #include <algorithm>
+#include <iterator>
 
 TransactionController::TransactionController(FileManager& fileManager,
                                              ProductController& productController,
@@ -13,253 +15,1321 @@ TransactionController::TransactionController(FileManager& fileManager,
     : m_fileManager(fileManager)
     , m_productController(productController)
     , m_customerController(customerController)
+    , m_logRecordCount(0)
+    , m_checkpointGeneration(0)
+    , m_checkpointRequired(false)
+    , m_pendingCheckpoints(0)
+    , m_sealedUntil(0)
+    , m_defaultSession(std::make_shared<CheckoutSession>())
+    , m_nextSessionId(DEFAULT_SESSION + 1)
+    , m_idEpoch(0)
 {
+    resetCart(m_defaultSession->cart, 0);
 }
 
 std::vector<Transaction> TransactionController::getAll() const {
-    return m_transactions;
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+    return m_transactions.values();
 }
 
 Transaction* TransactionController::getById(int id) {
-    auto it = std::find_if(m_transactions.begin(), m_transactions.end(),
-        [id](const Transaction& t) {
-            return t.getId() == id;
-        });
+    std::lock_guard<std::mutex> lock(m_historyMutex);
 
-    if (it != m_transactions.end()) {
-        return &(*it);
+    auto it = m_index.find(id);
+    if (it == m_index.end()) {
+        loadSegmentsForId(id);
+        it = m_index.find(id);
+    }
+    if (it != m_index.end()) {
+        return m_transactions.get(it->second);
     }
     return nullptr;
 }
 
 bool TransactionController::add(const Transaction& transaction) {
-    if (!transaction.isValid()) {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    loadSegmentsForId(transaction.getId());
+    if (!transaction.isValid() || m_index.count(transaction.getId()) > 0) {
         return false;
     }
 
-    IdGenerator::getInstance().updateCounter("transaction", transaction.getId());
-    m_transactions.push_back(transaction);
+    IdGenerator::getInstance().updateCounter(EntityType::Transaction, transaction.getId());
+    touchSegment(transaction.getTimestamp());
+    discardArchive(transaction.getTimestamp());
+    store(transaction);
+    appendToLog(transaction, PointsBalance());
     return true;
 }
 
 bool TransactionController::update(const Transaction& transaction) {
-    Transaction* existing = getById(transaction.getId());
-    if (!existing) {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    if (m_index.count(transaction.getId()) == 0) {
+        loadSegmentsForId(transaction.getId());
+    }
+    auto it = m_index.find(transaction.getId());
+    if (it == m_index.end()) {
         return false;
     }
 
-    *existing = transaction;
+    // Touching a segment may load one, so keep the handle, not the iterator
+    SlotHandle handle = it->second;
+    std::int64_t previousTimestamp = m_transactions.get(handle)->getTimestamp();
+    touchSegment(previousTimestamp);
+    touchSegment(transaction.getTimestamp());
+    discardArchive(previousTimestamp);
+    discardArchive(transaction.getTimestamp());
+    replace(handle, transaction);
+    appendToLog(transaction, PointsBalance());
     return true;
 }
 
+void TransactionController::replace(SlotHandle handle, const Transaction& transaction) {
+    Transaction* existing = m_transactions.get(handle);
+    bool moved = existing->getTimestamp() != transaction.getTimestamp();
+    if (moved) {
+        unindexTime(existing->getTimestamp(), handle);
+        indexTime(transaction.getTimestamp(), handle);
+    }
+
+    // Posting lists are in time order too, so re-file on either change
+    bool refile = moved || existing->getCustomerId() != transaction.getCustomerId();
+    if (refile) {
+        unindexCustomer(existing->getCustomerId(), handle);
+    }
+
+    m_aggregates.remove(*existing);
+    m_aggregates.add(transaction);
+    *existing = transaction;
+
+    if (refile) {
+        indexCustomer(transaction.getCustomerId(), handle);
+    }
+}
+
 bool TransactionController::remove(int id) {
-    auto it = std::find_if(m_transactions.begin(), m_transactions.end(),
-        [id](const Transaction& t) {
-            return t.getId() == id;
-        });
+    std::lock_guard<std::mutex> lock(m_historyMutex);
 
-    if (it != m_transactions.end()) {
-        m_transactions.erase(it);
-        return true;
+    if (m_index.count(id) == 0) {
+        loadSegmentsForId(id);
     }
-    return false;
+    auto it = m_index.find(id);
+    if (it == m_index.end()) {
+        return false;
+    }
+
+    std::int64_t timestamp = m_transactions.get(it->second)->getTimestamp();
+    touchSegment(timestamp);
+    discardArchive(timestamp);
+    erase(id);
+
+    appendDeletionToLog(id);
+    return true;
+}
+
+bool TransactionController::erase(int id) {
+    auto it = m_index.find(id);
+    if (it == m_index.end()) {
+        return false;
+    }
+
+    const Transaction* existing = m_transactions.get(it->second);
+    unindexTime(existing->getTimestamp(), it->second);
+    unindexCustomer(existing->getCustomerId(), it->second);
+    m_aggregates.remove(*existing);
+    m_transactions.erase(it->second);
+    m_index.erase(it);
+    return true;
 }
 
 bool TransactionController::saveToFile() {
-    std::vector<std::string> lines;
-    lines.reserve(m_transactions.size());
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+    return writeCheckpoint();
+}
 
-    for (const auto& transaction : m_transactions) {
-        lines.push_back(transaction.serialize());
+bool TransactionController::writeCheckpoint() {
+    if (m_pendingCheckpoints > 0) {
+        // A background checkpoint would later overwrite this one with older data
+        return false;
     }
 
-    return m_fileManager.writeLines(FILENAME, lines);
+    for (const auto& file : serializeCheckpoint()) {
+        if (!m_fileManager.writeBuffer(file.filename, file.data)) {
+            markLoadedSegmentsDirty();
+            return false;
+        }
+    }
+
+    // Everything in the logs is now part of the checkpoint
+    m_logRecordCount = 0;
+    m_checkpointRequired = false;
+    m_fileManager.removeFile(ROTATED_LOG_FILENAME);
+    return m_fileManager.writeLines(LOG_FILENAME, {});
 }
 
-bool TransactionController::loadFromFile() {
+std::vector<PendingFile> TransactionController::beginCheckpoint(int& generation) {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    rotateLog();
+    m_logRecordCount = 0;
+    m_checkpointRequired = false;
+    ++m_pendingCheckpoints;
+    generation = ++m_checkpointGeneration;
+
+    return serializeCheckpoint();
+}
+
+void TransactionController::finishCheckpoint(int generation, bool success) {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+    --m_pendingCheckpoints;
+
+    // Only the newest checkpoint covers everything in the rotated log
+    if (generation == m_checkpointGeneration) {
+        if (success) {
+            m_fileManager.removeFile(ROTATED_LOG_FILENAME);
+        } else {
+            m_checkpointRequired = true;  // Retry on the next save
+            markLoadedSegmentsDirty();
+        }
+    }
+}
+
+bool TransactionController::needsCheckpoint() const {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+    return checkpointDue() || segmentsDue();
+}
+
+bool TransactionController::checkpointDue() const {
+    return m_checkpointRequired ||
+           m_logRecordCount >= std::max(CHECKPOINT_INTERVAL, m_transactions.size() / 2);
+}
+
+void TransactionController::writeImage(BinaryWriter& writer) const {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    // Sealed months stay in their segment files. In time order, so
+    // reloading appends to the time index
+    auto first = std::lower_bound(m_timeIndex.begin(), m_timeIndex.end(), m_sealedUntil,
+        [](const TimeEntry& entry, std::int64_t value) {
+            return entry.timestamp < value;
+        });
+    writer.put(static_cast<std::uint32_t>(m_timeIndex.end() - first));
+    for (auto it = first; it != m_timeIndex.end(); ++it) {
+        m_transactions.get(it->handle)->writeBinary(writer);
+    }
+    writer.put(static_cast<std::uint64_t>(m_logRecordCount));
+}
+
+bool TransactionController::readImage(BinaryReader& reader) {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
     m_transactions.clear();
+    m_index.clear();
+    m_timeIndex.clear();
+    m_byCustomer.clear();
+    m_aggregates.clear();
+
+    std::uint32_t count = reader.get<std::uint32_t>();
+    m_transactions.reserve(count);
+    m_index.reserve(count);
+    m_timeIndex.reserve(count);
+
+    int lastId = 0;
+    for (std::uint32_t i = 0; i < count && reader.ok(); ++i) {
+        Transaction transaction;
+        if (!transaction.readBinary(reader) || m_index.count(transaction.getId()) > 0) {
+            return false;
+        }
+
+        resolveItemDetails(transaction);
+        lastId = std::max(lastId, transaction.getId());
+        store(std::move(transaction));
+    }
+    IdGenerator::getInstance().updateCounter(EntityType::Transaction, lastId);
+
+    m_logRecordCount = static_cast<std::size_t>(reader.get<std::uint64_t>());
+    m_checkpointRequired = false;
+    loadManifest();
+    indexArchives();
+
+    // Sessions lease again, above every ID just loaded
+    ++m_idEpoch;
+    return reader.ok();
+}
+
+std::string TransactionController::archiveFilename(std::int64_t timestamp) {
+    return ARCHIVE_PREFIX + DateTime::formatMonth(timestamp) + ARCHIVE_EXTENSION;
+}
+
+std::vector<PendingFile> TransactionController::snapshotArchives() {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    std::vector<PendingFile> files;
+    std::int64_t currentMonth = DateTime::startOfMonth(DateTime::now());
+    auto byTimestamp = [](const TimeEntry& entry, std::int64_t value) {
+        return entry.timestamp < value;
+    };
+
+    // Walk the time index a month at a time, up to the open month
+    for (auto first = m_timeIndex.begin();
+         first != m_timeIndex.end() && first->timestamp < currentMonth;) {
+        std::int64_t month = DateTime::startOfMonth(first->timestamp);
+        auto last = std::lower_bound(first, m_timeIndex.end(),
+                                     DateTime::startOfNextMonth(month), byTimestamp);
+
+        if (m_archivedMonths.count(month) == 0) {
+            std::vector<const Transaction*> rows;
+            rows.reserve(static_cast<std::size_t>(last - first));
+            for (auto it = first; it != last; ++it) {
+                rows.push_back(m_transactions.get(it->handle));
+            }
+
+            auto generation = m_archiveGenerations.find(month);
+            files.push_back(PendingFile{archiveFilename(month), TransactionArchive::encode(rows,
+                (generation != m_archiveGenerations.end()) ? generation->second : 0)});
+            m_archivedMonths.insert(month);
+        }
+        first = last;
+    }
+
+    return files;
+}
+
+void TransactionController::scanArchives() {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+    indexArchives();
+}
 
-    std::vector<std::string> lines = m_fileManager.readLines(FILENAME);
+void TransactionController::indexArchives() {
+    m_archivedMonths.clear();
 
-    for (const auto& line : lines) {
-        if (line.empty()) continue;
+    std::int64_t currentMonth = DateTime::startOfMonth(DateTime::now());
+    for (auto it = m_timeIndex.begin(); it != m_timeIndex.end() && it->timestamp < currentMonth;) {
+        std::int64_t month = DateTime::startOfMonth(it->timestamp);
+        TransactionArchive archive;
+        if (openArchive(month, archive)) {
+            m_archivedMonths.insert(month);
+        }
+
+        std::int64_t next = DateTime::startOfNextMonth(month);
+        it = std::lower_bound(it, m_timeIndex.end(), next,
+            [](const TimeEntry& entry, std::int64_t value) {
+                return entry.timestamp < value;
+            });
+    }
+}
+
+void TransactionController::discardArchive(std::int64_t timestamp) {
+    std::int64_t month = DateTime::startOfMonth(timestamp);
+    if (month >= DateTime::startOfMonth(DateTime::now())) {
+        return;
+    }
+
+    // Removed even when not indexed: the month may not be loaded, or this
+    // may be a change replayed from the log over an archive written later
+    ++m_archiveGenerations[month];
+    m_archivedMonths.erase(month);
+    m_fileManager.removeFile(archiveFilename(month));
+}
+
+bool TransactionController::openArchive(std::int64_t month, TransactionArchive& archive) const {
+    if (!archive.open(m_fileManager, archiveFilename(month))) {
+        return false;
+    }
+
+    auto it = m_archiveGenerations.find(month);
+    return it == m_archiveGenerations.end() || archive.getGeneration() == it->second;
+}
+
+// ============ Monthly Segments ============
+
+std::string TransactionController::segmentFilename(std::int64_t timestamp) {
+    return ARCHIVE_PREFIX + DateTime::formatMonth(timestamp) + SEGMENT_EXTENSION;
+}
+
+void TransactionController::loadManifest() {
+    m_segments.clear();
+    m_sealedUntil = 0;
+
+    MappedFile file = m_fileManager.mapFile(MANIFEST_FILENAME);
+    for (std::string_view line : file) {
+        std::string_view fields[5];
+        std::size_t count = FileManager::splitFields(line, '|', fields, 5);
+
+        if (count == 2 && fields[0] == "sealed") {
+            DateTime::parseMonth(fields[1], m_sealedUntil);
+            continue;
+        }
+
+        std::int64_t month = 0;
+        Segment segment;
+        if (count >= 4 && DateTime::parseMonth(fields[0], month) &&
+            FileManager::parseInt(fields[1], segment.count) &&
+            FileManager::parseInt(fields[2], segment.firstId) &&
+            FileManager::parseInt(fields[3], segment.lastId)) {
+            // Revenue was added later; sum an older manifest's months once
+            if (count < 5 || !FileManager::parseMoney(fields[4], segment.revenue)) {
+                segment.revenue = readSegmentRevenue(month);
+            }
+            IdGenerator::getInstance().updateCounter(EntityType::Transaction, segment.lastId);
+            m_segments[month] = segment;
+        }
+    }
+}
 
+Money TransactionController::readSegmentRevenue(std::int64_t month) const {
+    Money revenue = 0;
+    MappedFile file = m_fileManager.mapFile(segmentFilename(month));
+    for (std::string_view line : file) {
         Transaction transaction;
         transaction.deserialize(line);
-
         if (transaction.isValid()) {
-            // Populate product names and prices for items
-            for (auto& item : const_cast<std::vector<TransactionItem>&>(transaction.getItems())) {
-                Product* product = m_productController.getById(item.getProductId());
-                if (product) {
-                    item.setProductName(product->getName());
-                    item.setUnitPrice(product->getPrice());
+            revenue += transaction.getTotal();
+        }
+    }
+    return revenue;
+}
+
+std::string TransactionController::serializeManifest() const {
+    std::string buffer =
+        "# Transaction segments: months before 'sealed' are in transactions-YYYY-MM.txt\n"
+        "# Format: sealed|first_unsealed_month, then month|transaction_count|first_id|last_id|revenue\n";
+
+    if (m_sealedUntil != 0) {
+        buffer += "sealed|";
+        buffer += DateTime::formatMonth(m_sealedUntil);
+        buffer += '\n';
+    }
+
+    for (const auto& [month, segment] : m_segments) {
+        buffer += DateTime::formatMonth(month);
+        buffer += '|';
+        FileManager::appendInt(buffer, segment.count);
+        buffer += '|';
+        FileManager::appendInt(buffer, segment.firstId);
+        buffer += '|';
+        FileManager::appendInt(buffer, segment.lastId);
+        buffer += '|';
+        FileManager::appendInt(buffer, segment.revenue);
+        buffer += '\n';
+    }
+
+    return buffer;
+}
+
+void TransactionController::loadSegment(std::int64_t month) {
+    // A month with no file yet (first change to an empty sealed month) is
+    // simply created empty
+    Segment& segment = m_segments[month];
+    if (segment.loaded) {
+        return;
+    }
+    segment.loaded = true;
+
+    // The month sits before later loaded rows in time, so index it on its
+    // own and merge it in once instead of inserting row by row
+    std::vector<TimeEntry> loaded;
+    loaded.swap(m_timeIndex);
+    std::unordered_map<int, std::vector<SlotHandle>> loadedPostings;
+    loadedPostings.swap(m_byCustomer);
+
+    MappedFile file = m_fileManager.mapFile(segmentFilename(month));
+    for (std::string_view line : file) {
+        Transaction transaction;
+        transaction.deserialize(line);
+
+        if (transaction.isValid() && m_index.count(transaction.getId()) == 0) {
+            resolveItemDetails(transaction);
+            IdGenerator::getInstance().updateCounter(EntityType::Transaction, transaction.getId());
+            store(std::move(transaction));
+        }
+    }
+
+    std::vector<TimeEntry> merged;
+    merged.reserve(loaded.size() + m_timeIndex.size());
+    std::merge(m_timeIndex.begin(), m_timeIndex.end(), loaded.begin(), loaded.end(),
+               std::back_inserter(merged),
+               [](const TimeEntry& a, const TimeEntry& b) {
+                   return a.timestamp < b.timestamp;
+               });
+    m_timeIndex.swap(merged);
+
+    auto byTime = [this](SlotHandle a, SlotHandle b) {
+        return m_transactions.get(a)->getTimestamp() < m_transactions.get(b)->getTimestamp();
+    };
+    for (const auto& [customerId, postings] : m_byCustomer) {
+        std::vector<SlotHandle>& existing = loadedPostings[customerId];
+        std::size_t size = existing.size();
+        existing.insert(existing.end(), postings.begin(), postings.end());
+        std::inplace_merge(existing.begin(), existing.begin() + static_cast<std::ptrdiff_t>(size),
+                           existing.end(), byTime);
+    }
+    m_byCustomer.swap(loadedPostings);
+
+    TransactionArchive archive;
+    if (openArchive(month, archive)) {
+        m_archivedMonths.insert(month);
+    }
+}
+
+void TransactionController::loadSegmentsInRange(std::int64_t from, std::int64_t to) {
+    for (auto it = m_segments.lower_bound(DateTime::startOfMonth(from));
+         it != m_segments.end() && it->first < to; ++it) {
+        loadSegment(it->first);
+    }
+}
+
+void TransactionController::loadRecentSegments(std::size_t count) {
+    // A loaded older month must not hide a newer one still on disk
+    for (auto it = m_segments.rbegin(); it != m_segments.rend(); ++it) {
+        if (it->second.loaded || it->second.count == 0) {
+            continue;
+        }
+
+        auto newer = std::lower_bound(m_timeIndex.begin(), m_timeIndex.end(),
+            DateTime::startOfNextMonth(it->first),
+            [](const TimeEntry& entry, std::int64_t value) {
+                return entry.timestamp < value;
+            });
+        if (static_cast<std::size_t>(m_timeIndex.end() - newer) >= count) {
+            return;
+        }
+        loadSegment(it->first);
+    }
+}
+
+void TransactionController::loadSegmentsForId(int id) {
+    for (const auto& [month, segment] : m_segments) {
+        if (!segment.loaded && segment.count > 0 &&
+            id >= segment.firstId && id <= segment.lastId) {
+            loadSegment(month);
+        }
+    }
+}
+
+void TransactionController::loadSegmentsForCustomer(int customerId) {
+    std::vector<std::int64_t> customers;
+
+    for (const auto& [month, segment] : m_segments) {
+        if (segment.loaded || segment.count == 0) {
+            continue;
+        }
+
+        // Without a matching archive the month has to be loaded to know
+        TransactionArchive archive;
+        bool mayContain = true;
+        if (openArchive(month, archive) &&
+            archive.getRowCount() == static_cast<std::uint64_t>(segment.count)) {
+            mayContain = false;
+            for (std::size_t block = 0; block < archive.getBlockCount() && !mayContain; ++block) {
+                const ArchiveChunk& chunk = archive.getChunk(block, ArchiveColumn::CustomerId);
+                if (customerId < chunk.min || customerId > chunk.max) {
+                    continue;
                 }
+                mayContain = !archive.readColumn(block, ArchiveColumn::CustomerId, customers) ||
+                             std::find(customers.begin(), customers.end(), customerId) != customers.end();
+            }
+        }
+
+        if (mayContain) {
+            loadSegment(month);
+        }
+    }
+}
+
+void TransactionController::touchSegment(std::int64_t timestamp) {
+    if (timestamp >= m_sealedUntil) {
+        return;
+    }
+
+    std::int64_t month = DateTime::startOfMonth(timestamp);
+    loadSegment(month);
+    m_segments[month].dirty = true;
+}
+
+std::vector<PendingFile> TransactionController::serializeCheckpoint() {
+    auto byTimestamp = [](const TimeEntry& entry, std::int64_t value) {
+        return entry.timestamp < value;
+    };
+
+    // Seal the months that have ended since the last checkpoint
+    std::int64_t currentMonth = DateTime::startOfMonth(DateTime::now());
+    if (currentMonth > m_sealedUntil) {
+        auto it = std::lower_bound(m_timeIndex.begin(), m_timeIndex.end(), m_sealedUntil, byTimestamp);
+        while (it != m_timeIndex.end() && it->timestamp < currentMonth) {
+            std::int64_t month = DateTime::startOfMonth(it->timestamp);
+            Segment& segment = m_segments[month];
+            segment.loaded = true;
+            segment.dirty = true;
+            it = std::lower_bound(it, m_timeIndex.end(), DateTime::startOfNextMonth(month), byTimestamp);
+        }
+        m_sealedUntil = currentMonth;
+    }
+
+    std::vector<PendingFile> files;
+    for (auto& [month, segment] : m_segments) {
+        if (!segment.dirty) {
+            continue;
+        }
+
+        auto first = std::lower_bound(m_timeIndex.begin(), m_timeIndex.end(), month, byTimestamp);
+        auto last = std::lower_bound(first, m_timeIndex.end(), DateTime::startOfNextMonth(month), byTimestamp);
+
+        PendingFile file{segmentFilename(month), std::string()};
+        file.data.reserve(static_cast<std::size_t>(last - first) * RECORD_SIZE_HINT);
+        segment.count = 0;
+        segment.firstId = 0;
+        segment.lastId = 0;
+        segment.revenue = 0;
+        for (auto it = first; it != last; ++it) {
+            const Transaction* transaction = m_transactions.get(it->handle);
+            transaction->serializeTo(file.data);
+            file.data += '\n';
+
+            int id = transaction->getId();
+            segment.firstId = (segment.count == 0) ? id : std::min(segment.firstId, id);
+            segment.lastId = std::max(segment.lastId, id);
+            segment.revenue += transaction->getTotal();
+            ++segment.count;
+        }
+
+        files.push_back(std::move(file));
+        segment.dirty = false;
+    }
+
+    files.push_back(PendingFile{MANIFEST_FILENAME, serializeManifest()});
+
+    PendingFile checkpoint{FILENAME, std::string()};
+    auto first = std::lower_bound(m_timeIndex.begin(), m_timeIndex.end(), m_sealedUntil, byTimestamp);
+    checkpoint.data.reserve(static_cast<std::size_t>(m_timeIndex.end() - first) * RECORD_SIZE_HINT);
+    for (auto it = first; it != m_timeIndex.end(); ++it) {
+        m_transactions.get(it->handle)->serializeTo(checkpoint.data);
+        checkpoint.data += '\n';
+    }
+    files.push_back(std::move(checkpoint));
+
+    return files;
+}
+
+bool TransactionController::segmentsDue() const {
+    for (const auto& entry : m_segments) {
+        if (entry.second.dirty) {
+            return true;
+        }
+    }
+
+    // Any loaded transaction from an ended month that is not sealed yet
+    auto first = std::lower_bound(m_timeIndex.begin(), m_timeIndex.end(), m_sealedUntil,
+        [](const TimeEntry& entry, std::int64_t value) {
+            return entry.timestamp < value;
+        });
+    return first != m_timeIndex.end() &&
+           first->timestamp < DateTime::startOfMonth(DateTime::now());
+}
+
+void TransactionController::markLoadedSegmentsDirty() {
+    for (auto& entry : m_segments) {
+        if (entry.second.loaded) {
+            entry.second.dirty = true;
+        }
+    }
+}
+
+Money TransactionController::getArchivedRevenue(std::int64_t from, std::int64_t to) const {
+    Money revenue = 0;
+    std::vector<std::int64_t> timestamps;
+    std::vector<std::int64_t> totals;
+
+    for (std::int64_t month = DateTime::startOfMonth(from); month < to;
+         month = DateTime::startOfNextMonth(month)) {
+        TransactionArchive archive;
+        if (!openArchive(month, archive)) {
+            continue;
+        }
+
+        for (std::size_t block = 0; block < archive.getBlockCount(); ++block) {
+            const ArchiveChunk& times = archive.getChunk(block, ArchiveColumn::Timestamp);
+            if (times.count == 0 || times.max < from || times.min >= to) {
+                continue;
+            }
+            if (!archive.readColumn(block, ArchiveColumn::Total, totals)) {
+                continue;
+            }
+
+            if (times.min >= from && times.max < to) {
+                for (std::int64_t total : totals) {
+                    revenue += total;
+                }
+            } else if (archive.readColumn(block, ArchiveColumn::Timestamp, timestamps)) {
+                for (std::size_t i = 0; i < timestamps.size() && i < totals.size(); ++i) {
+                    if (timestamps[i] >= from && timestamps[i] < to) {
+                        revenue += totals[i];
+                    }
+                }
+            }
+        }
+    }
+
+    return revenue;
+}
+
+void TransactionController::rotateLog() {
+    if (!m_fileManager.fileExists(LOG_FILENAME)) {
+        return;
+    }
+
+    if (!m_fileManager.fileExists(ROTATED_LOG_FILENAME)) {
+        m_fileManager.renameFile(LOG_FILENAME, ROTATED_LOG_FILENAME);
+        return;
+    }
+
+    // An earlier checkpoint has not landed yet; keep its records and add ours
+    std::string frames;
+    for (const auto& record : m_fileManager.readRecords(LOG_FILENAME)) {
+        FileManager::frameRecord(frames, record);
+    }
+    if (m_fileManager.appendBuffer(ROTATED_LOG_FILENAME, frames)) {
+        m_fileManager.removeFile(LOG_FILENAME);
+    }
+}
+
+bool TransactionController::loadFromFile() {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    m_transactions.clear();
+    m_index.clear();
+    m_timeIndex.clear();
+    m_byCustomer.clear();
+    m_aggregates.clear();
+    m_logRecordCount = 0;
+
+    // Sealed months stay on disk until a query needs them
+    loadManifest();
+
+    MappedFile file = m_fileManager.mapFile(FILENAME);
+
+    for (std::string_view line : file) {
+        Transaction transaction;
+        transaction.deserialize(line);
+
+        // Older rows are left over from a checkpoint interrupted after
+        // segments.txt was replaced; their segment files are authoritative
+        if (transaction.isValid() && transaction.getTimestamp() >= m_sealedUntil &&
+            m_index.count(transaction.getId()) == 0) {
+            resolveItemDetails(transaction);
+
+            IdGenerator::getInstance().updateCounter(EntityType::Transaction, transaction.getId());
+            store(std::move(transaction));
+        }
+    }
+
+    // Replay the log tail, oldest first: a log rotated for a background
+    // checkpoint that never landed, then the current log
+    replayLog(ROTATED_LOG_FILENAME);
+    replayLog(LOG_FILENAME);
+
+    // Drop torn tails so records appended from now on can be read back
+    m_fileManager.truncateRecords(ROTATED_LOG_FILENAME);
+    m_fileManager.truncateRecords(LOG_FILENAME);
+
+    indexArchives();
+
+    // Sessions lease again, above every ID just loaded
+    ++m_idEpoch;
+    return true;
+}
+
+void TransactionController::replayLog(const std::string& filename) {
+    for (const auto& record : m_fileManager.readRecords(filename)) {
+        ++m_logRecordCount;
+
+        // Changes to sealed months load the month and mark it for rewriting;
+        // changes to any closed month drop its archive, which may predate them
+        int id = 0;
+        if (FileManager::parseDeletion(record, id)) {
+            if (m_index.count(id) == 0) {
+                loadSegmentsForId(id);
+            }
+            auto it = m_index.find(id);
+            if (it != m_index.end()) {
+                std::int64_t timestamp = m_transactions.get(it->second)->getTimestamp();
+                touchSegment(timestamp);
+                discardArchive(timestamp);
+                erase(id);
             }
+            continue;
+        }
+
+        // A sale's points may not have reached customers.txt before a crash
+        std::string_view payload = record;
+        PointsBalance balance;
+        if (parsePointsBalance(payload, balance)) {
+            m_customerController.replayLoyaltyPoints(balance.customerId, balance.points,
+                                                     balance.version);
+        }
+
+        Transaction transaction;
+        transaction.deserialize(payload);
+        if (!transaction.isValid()) {
+            continue;
+        }
+
+        resolveItemDetails(transaction);
+        IdGenerator::getInstance().updateCounter(EntityType::Transaction, transaction.getId());
+        loadSegmentsForId(transaction.getId());
+        touchSegment(transaction.getTimestamp());
+        discardArchive(transaction.getTimestamp());
+
+        auto it = m_index.find(transaction.getId());
+        if (it != m_index.end()) {
+            SlotHandle handle = it->second;
+            touchSegment(m_transactions.get(handle)->getTimestamp());
+            discardArchive(m_transactions.get(handle)->getTimestamp());
+            replace(handle, transaction);
+        } else {
+            store(transaction);
+        }
+    }
+}
+
+void TransactionController::store(Transaction transaction) {
+    SlotHandle handle = m_transactions.insert(std::move(transaction));
+    const Transaction& stored = *m_transactions.get(handle);
+    m_index[stored.getId()] = handle;
+    indexTime(stored.getTimestamp(), handle);
+    indexCustomer(stored.getCustomerId(), handle);
+    m_aggregates.add(stored);
+}
+
+void TransactionController::indexTime(std::int64_t timestamp, SlotHandle handle) {
+    // Sales normally arrive in time order, making this an append
+    if (m_timeIndex.empty() || m_timeIndex.back().timestamp <= timestamp) {
+        m_timeIndex.push_back(TimeEntry{timestamp, handle});
+        return;
+    }
+
+    auto position = std::upper_bound(m_timeIndex.begin(), m_timeIndex.end(), timestamp,
+        [](std::int64_t value, const TimeEntry& entry) {
+            return value < entry.timestamp;
+        });
+    m_timeIndex.insert(position, TimeEntry{timestamp, handle});
+}
+
+void TransactionController::unindexTime(std::int64_t timestamp, SlotHandle handle) {
+    auto it = std::lower_bound(m_timeIndex.begin(), m_timeIndex.end(), timestamp,
+        [](const TimeEntry& entry, std::int64_t value) {
+            return entry.timestamp < value;
+        });
+
+    for (; it != m_timeIndex.end() && it->timestamp == timestamp; ++it) {
+        if (it->handle == handle) {
+            m_timeIndex.erase(it);
+            return;
+        }
+    }
+}
+
+SlotHandle TransactionController::getHandle(int id) const {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    auto it = m_index.find(id);
+    return (it != m_index.end()) ? it->second : SlotHandle();
+}
+
+Transaction* TransactionController::get(SlotHandle handle) {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+    return m_transactions.get(handle);
+}
+
+void TransactionController::indexCustomer(int customerId, SlotHandle handle) {
+    std::vector<SlotHandle>& postings = m_byCustomer[customerId];
+    std::int64_t timestamp = m_transactions.get(handle)->getTimestamp();
+
+    // Sales normally arrive in time order, making this an append
+    if (postings.empty() || m_transactions.get(postings.back())->getTimestamp() <= timestamp) {
+        postings.push_back(handle);
+        return;
+    }
+
+    auto position = std::upper_bound(postings.begin(), postings.end(), timestamp,
+        [this](std::int64_t value, SlotHandle entry) {
+            return value < m_transactions.get(entry)->getTimestamp();
+        });
+    postings.insert(position, handle);
+}
+
+void TransactionController::unindexCustomer(int customerId, SlotHandle handle) {
+    auto it = m_byCustomer.find(customerId);
+    if (it == m_byCustomer.end()) {
+        return;
+    }
+
+    std::vector<SlotHandle>& postings = it->second;
+    postings.erase(std::remove(postings.begin(), postings.end(), handle), postings.end());
+    if (postings.empty()) {
+        m_byCustomer.erase(it);
+    }
+}
+
+void TransactionController::resolveItemDetails(Transaction& transaction) {
+    // Populate product names and prices for items
+    for (auto& item : const_cast<std::vector<TransactionItem>&>(transaction.getItems())) {
+        Product* product = m_productController.getById(item.getProductId());
+        if (product) {
+            item.setProductName(product->getName());
+            item.setUnitPrice(product->getPrice());
+        }
+    }
+}
 
-            IdGenerator::getInstance().updateCounter("transaction", transaction.getId());
-            m_transactions.push_back(transaction);
+bool TransactionController::appendToLog(const Transaction& transaction,
+                                        const PointsBalance& balance) {
+    m_logBuffer.clear();
+    if (balance.customerId > 0) {
+        m_logBuffer += "+|";
+        FileManager::appendInt(m_logBuffer, balance.customerId);
+        m_logBuffer += '|';
+        FileManager::appendInt(m_logBuffer, balance.points);
+        m_logBuffer += '|';
+        FileManager::appendInt(m_logBuffer, balance.version);
+        m_logBuffer += '|';
+    }
+    transaction.serializeTo(m_logBuffer);
+    return writeLogRecord();
+}
+
+bool TransactionController::parsePointsBalance(std::string_view& record, PointsBalance& balance) {
+    if (record.size() < 2 || record[0] != '+' || record[1] != '|') {
+        return false;
+    }
+
+    // Three fields, then the transaction itself
+    std::string_view fields[3];
+    std::size_t start = 2;
+    for (auto& field : fields) {
+        std::size_t end = record.find('|', start);
+        if (end == std::string_view::npos) {
+            return false;
         }
+        field = record.substr(start, end - start);
+        start = end + 1;
+    }
+
+    if (!FileManager::parseInt(fields[0], balance.customerId) ||
+        !FileManager::parseInt(fields[1], balance.points) ||
+        !FileManager::parseUInt32(fields[2], balance.version)) {
+        return false;
     }
 
+    record.remove_prefix(start);
+    return true;
+}
+
+bool TransactionController::appendDeletionToLog(int id) {
+    m_logBuffer.clear();
+    FileManager::formatDeletion(m_logBuffer, id);
+    return writeLogRecord();
+}
+
+bool TransactionController::writeLogRecord() {
+    if (!m_fileManager.appendRecord(LOG_FILENAME, m_logBuffer)) {
+        // The next save must checkpoint whatever the caller keeps in memory
+        m_checkpointRequired = true;
+        return false;
+    }
+
+    // Checkpoints are never written here, on the checkout thread under the
+    // history lock: once due, needsCheckpoint() hands one to the next save
+    ++m_logRecordCount;
     return true;
 }
 
 int TransactionController::getCount() const {
-    return static_cast<int>(m_transactions.size());
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    // Sealed months still on disk count too
+    std::size_t count = m_transactions.size();
+    for (const auto& entry : m_segments) {
+        if (!entry.second.loaded) {
+            count += static_cast<std::size_t>(entry.second.count);
+        }
+    }
+    return static_cast<int>(count);
 }
 
-void TransactionController::startNewTransaction(int customerId) {
-    m_currentTransaction = Transaction();
-    m_currentTransaction.setCustomerId(customerId);
-    m_currentTransaction.setCurrentDateTime();
+// ============ Checkout Sessions ============
+
+std::shared_ptr<TransactionController::CheckoutSession>
+TransactionController::findSession(int sessionId) const {
+    if (sessionId == DEFAULT_SESSION) {
+        return m_defaultSession;
+    }
+
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    auto it = m_sessions.find(sessionId);
+    return (it != m_sessions.end()) ? it->second : nullptr;
 }
 
-Transaction& TransactionController::getCurrentTransaction() {
-    return m_currentTransaction;
+void TransactionController::resetCart(Transaction& cart, int customerId) {
+    cart = Transaction();
+    cart.setCustomerId(customerId);
+    cart.setCurrentDateTime();
 }
 
-const Transaction& TransactionController::getCurrentTransaction() const {
-    return m_currentTransaction;
+void TransactionController::leaseIds(CheckoutSession& session) {
+    // Epoch first: a load landing in between then marks this block stale
+    session.idEpoch = m_idEpoch.load();
+    session.ids = IdGenerator::getInstance().leaseBlock(EntityType::Transaction, ID_BLOCK_SIZE);
 }
 
-bool TransactionController::addToCart(int productId, int quantity) {
+bool TransactionController::takeId(CheckoutSession& session, int& id) {
+    if (session.idEpoch != m_idEpoch.load()) {
+        leaseIds(session);
+    }
+    if (session.ids.take(id)) {
+        return true;
+    }
+    leaseIds(session);
+    return session.ids.take(id);
+}
+
+int TransactionController::openSession(int customerId) {
+    auto session = std::make_shared<CheckoutSession>();
+    resetCart(session->cart, customerId);
+    leaseIds(*session);
+
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    int sessionId = m_nextSessionId++;
+    m_sessions[sessionId] = std::move(session);
+    return sessionId;
+}
+
+bool TransactionController::closeSession(int sessionId) {
+    if (sessionId == DEFAULT_SESSION) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    return m_sessions.erase(sessionId) > 0;
+}
+
+Transaction TransactionController::getSessionCart(int sessionId) const {
+    std::shared_ptr<CheckoutSession> session = findSession(sessionId);
+    if (!session) {
+        return Transaction();
+    }
+
+    std::lock_guard<std::mutex> lock(session->mutex);
+    return session->cart;
+}
+
+bool TransactionController::addToSessionCart(int sessionId, int productId, int quantity) {
+    std::shared_ptr<CheckoutSession> session = findSession(sessionId);
     Product* product = m_productController.getById(productId);
-    if (!product || quantity <= 0) {
+    if (!session || !product || quantity <= 0) {
         return false;
     }
 
     TransactionItem item(productId, product->getName(), product->getPrice(), quantity);
-    m_currentTransaction.addItem(item);
+
+    std::lock_guard<std::mutex> lock(session->mutex);
+    session->cart.addItem(item);
     return true;
 }
 
-bool TransactionController::removeFromCart(int productId) {
-    return m_currentTransaction.removeItem(productId);
-}
+bool TransactionController::removeFromSessionCart(int sessionId, int productId) {
+    std::shared_ptr<CheckoutSession> session = findSession(sessionId);
+    if (!session) {
+        return false;
+    }
 
-bool TransactionController::updateCartQuantity(int productId, int quantity) {
-    return m_currentTransaction.updateItemQuantity(productId, quantity);
+    std::lock_guard<std::mutex> lock(session->mutex);
+    return session->cart.removeItem(productId);
 }
 
-void TransactionController::clearCart() {
-    m_currentTransaction.clearItems();
+bool TransactionController::updateSessionCartQuantity(int sessionId, int productId, int quantity) {
+    std::shared_ptr<CheckoutSession> session = findSession(sessionId);
+    if (!session) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(session->mutex);
+    return session->cart.updateItemQuantity(productId, quantity);
 }
 
-void TransactionController::setCurrentCustomer(int customerId) {
-    m_currentTransaction.setCustomerId(customerId);
+bool TransactionController::setSessionCustomer(int sessionId, int customerId) {
+    std::shared_ptr<CheckoutSession> session = findSession(sessionId);
+    if (!session) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(session->mutex);
+    session->cart.setCustomerId(customerId);
     // Reset points usage when customer changes
-    m_currentTransaction.setPointsUsed(0);
+    session->cart.setPointsUsed(0);
+    return true;
 }
 
-bool TransactionController::setPointsToUse(int points) {
-    int customerId = m_currentTransaction.getCustomerId();
+bool TransactionController::setSessionPointsToUse(int sessionId, int points) {
+    std::shared_ptr<CheckoutSession> session = findSession(sessionId);
+    if (!session) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(session->mutex);
+    int customerId = session->cart.getCustomerId();
     if (customerId <= 0) {
         return false;
     }
 
-    Customer* customer = m_customerController.getById(customerId);
-    if (!customer) {
+    int balance = 0;
+    std::uint32_t version = 0;
+    if (!m_customerController.readLoyaltyPoints(customerId, balance, version)) {
         return false;
     }
 
-    // Check if customer has enough points
-    if (points > 0 && !customer->canRedeemPoints(points)) {
+    // Check if customer has enough points (re-checked when the sale completes)
+    if (points > 0 && !Customer::canRedeemFrom(balance, points)) {
         return false;
     }
 
-    m_currentTransaction.setPointsUsed(points);
+    session->cart.setPointsUsed(points);
     return true;
 }
 
-bool TransactionController::completeTransaction() {
-    if (!m_currentTransaction.hasItems()) {
+bool TransactionController::completeSession(int sessionId) {
+    std::shared_ptr<CheckoutSession> session = findSession(sessionId);
+    if (!session) {
         return false;
     }
 
-    // Generate ID
-    int id = IdGenerator::getInstance().getNextId("transaction");
-    m_currentTransaction.setId(id);
-    m_currentTransaction.setCurrentDateTime();
-    m_currentTransaction.recalculate();
+    std::lock_guard<std::mutex> lock(session->mutex);
+    Transaction& cart = session->cart;
+    if (!cart.hasItems()) {
+        return false;
+    }
 
-    int customerId = m_currentTransaction.getCustomerId();
-    int pointsUsed = m_currentTransaction.getPointsUsed();
-    int pointsEarned = m_currentTransaction.getPointsEarned();
+    cart.recalculate();
 
-    // Handle loyalty points
-    if (customerId > 0) {
-        // Deduct used points
-        if (pointsUsed > 0) {
-            if (!m_customerController.redeemLoyaltyPoints(customerId, pointsUsed)) {
-                return false;  // Failed to redeem points
-            }
+    {
+        std::lock_guard<std::mutex> historyLock(m_historyMutex);
+
+        // IDs come from the till's own block, so the shared counter is
+        // touched once per ID_BLOCK_SIZE sales. Tills interleave, so the
+        // log is in time order but not ID order; replay keys records by ID
+        // and applies them in log order, so it does not need ID order.
+        // Taken under the lock so a load cannot slip in between.
+        int id = 0;
+        if (!takeId(*session, id)) {
+            return false;
         }
+        cart.setId(id);
+        cart.setCurrentDateTime();
 
-        // Add earned points
-        if (pointsEarned > 0) {
-            m_customerController.addLoyaltyPoints(customerId, pointsEarned);
+        // If the sale cannot be logged, nothing was sold and the cart
+        // stays for a retry under the same ID
+        if (!logSale(cart)) {
+            session->ids.putBack(id);
+            return false;
         }
+        store(cart);
     }
 
-    // Add to history
-    m_transactions.push_back(m_currentTransaction);
-
     // Clear cart for next transaction
-    startNewTransaction(0);
-
+    resetCart(cart, 0);
     return true;
 }
 
+bool TransactionController::logSale(const Transaction& sale) {
+    int customerId = sale.getCustomerId();
+    int pointsUsed = sale.getPointsUsed();
+    int pointsEarned = sale.getPointsEarned();
+    if (customerId <= 0 || (pointsUsed <= 0 && pointsEarned <= 0)) {
+        return appendToLog(sale, PointsBalance());
+    }
+
+    for (int attempt = 0; attempt < MAX_POINT_RETRIES; ++attempt) {
+        int balance = 0;
+        std::uint32_t version = 0;
+        if (!m_customerController.readLoyaltyPoints(customerId, balance, version)) {
+            // Customer removed: a guest-style sale is fine, a redemption is not
+            return pointsUsed <= 0 && appendToLog(sale, PointsBalance());
+        }
+
+        if (pointsUsed > 0 && !Customer::canRedeemFrom(balance, pointsUsed)) {
+            return false;
+        }
+
+        // One log append makes the sale and its points durable together,
+        // before any other till can see the new balance
+        int newBalance = balance - std::max(pointsUsed, 0) + std::max(pointsEarned, 0);
+        bool attempted = false;
+        auto persist = [&](std::uint32_t newVersion) {
+            attempted = true;
+            return appendToLog(sale, PointsBalance{customerId, newBalance, newVersion});
+        };
+        if (m_customerController.commitLoyaltyPoints(customerId, version, newBalance, persist)) {
+            return true;
+        }
+        if (attempted) {
+            return false;  // The append failed; nothing was published
+        }
+        // Another till changed the balance in between; re-read and retry
+    }
+    return false;
+}
+
+// ============ Current Transaction (Cart) Operations ============
+
+void TransactionController::startNewTransaction(int customerId) {
+    std::lock_guard<std::mutex> lock(m_defaultSession->mutex);
+    resetCart(m_defaultSession->cart, customerId);
+}
+
+Transaction& TransactionController::getCurrentTransaction() {
+    return m_defaultSession->cart;
+}
+
+const Transaction& TransactionController::getCurrentTransaction() const {
+    return m_defaultSession->cart;
+}
+
+bool TransactionController::addToCart(int productId, int quantity) {
+    return addToSessionCart(DEFAULT_SESSION, productId, quantity);
+}
+
+bool TransactionController::removeFromCart(int productId) {
+    return removeFromSessionCart(DEFAULT_SESSION, productId);
+}
+
+bool TransactionController::updateCartQuantity(int productId, int quantity) {
+    return updateSessionCartQuantity(DEFAULT_SESSION, productId, quantity);
+}
+
+void TransactionController::clearCart() {
+    std::lock_guard<std::mutex> lock(m_defaultSession->mutex);
+    m_defaultSession->cart.clearItems();
+}
+
+void TransactionController::setCurrentCustomer(int customerId) {
+    setSessionCustomer(DEFAULT_SESSION, customerId);
+}
+
+bool TransactionController::setPointsToUse(int points) {
+    return setSessionPointsToUse(DEFAULT_SESSION, points);
+}
+
+bool TransactionController::completeTransaction() {
+    return completeSession(DEFAULT_SESSION);
+}
+
 void TransactionController::cancelTransaction() {
-    m_currentTransaction = Transaction();
+    std::lock_guard<std::mutex> lock(m_defaultSession->mutex);
+    m_defaultSession->cart = Transaction();
 }
 
 bool TransactionController::hasItemsInCart() const {
-    return m_currentTransaction.hasItems();
+    std::lock_guard<std::mutex> lock(m_defaultSession->mutex);
+    return m_defaultSession->cart.hasItems();
 }
 
+// ============ Query Methods ============
+
 std::vector<Transaction*> TransactionController::getByCustomerId(int customerId) {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    loadSegmentsForCustomer(customerId);
     std::vector<Transaction*> result;
 
-    for (auto& transaction : m_transactions) {
-        if (transaction.getCustomerId() == customerId) {
-            result.push_back(&transaction);
-        }
+    auto it = m_byCustomer.find(customerId);
+    if (it == m_byCustomer.end()) {
+        return result;
+    }
+
+    result.reserve(it->second.size());
+    for (SlotHandle handle : it->second) {
+        result.push_back(m_transactions.get(handle));
     }
 
     return result;
 }
 
+int TransactionController::getCountByCustomerId(int customerId) {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    loadSegmentsForCustomer(customerId);
+    auto it = m_byCustomer.find(customerId);
+    return (it != m_byCustomer.end()) ? static_cast<int>(it->second.size()) : 0;
+}
+
 std::vector<Transaction*> TransactionController::getByDateRange(const std::string& startDate,
                                                                  const std::string& endDate) {
+    std::int64_t from = 0;
+    std::int64_t to = 0;
+    if (!DateTime::parse(startDate, from) || !DateTime::parse(endDate, to)) {
+        return {};
+    }
+
+    // End date is inclusive: stop at midnight of the following day
+    return getByTimeRange(DateTime::startOfDay(from),
+                          DateTime::startOfDay(to) + DateTime::SECONDS_PER_DAY);
+}
+
+std::vector<Transaction*> TransactionController::getByTimeRange(std::int64_t from, std::int64_t to) {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
     std::vector<Transaction*> result;
+    if (from >= to) {
+        return result;
+    }
 
-    for (auto& transaction : m_transactions) {
-        std::string date = transaction.getDateTime().substr(0, 10);  // YYYY-MM-DD
-        if (date >= startDate && date <= endDate) {
-            result.push_back(&transaction);
-        }
+    loadSegmentsInRange(from, to);
+    auto byTimestamp = [](const TimeEntry& entry, std::int64_t value) {
+        return entry.timestamp < value;
+    };
+    auto first = std::lower_bound(m_timeIndex.begin(), m_timeIndex.end(), from, byTimestamp);
+    auto last = std::lower_bound(first, m_timeIndex.end(), to, byTimestamp);
+
+    result.reserve(static_cast<std::size_t>(last - first));
+    for (auto it = first; it != last; ++it) {
+        result.push_back(m_transactions.get(it->handle));
     }
 
     return result;
 }
 
-double TransactionController::getTotalRevenue() const {
-    double total = 0.0;
-    for (const auto& transaction : m_transactions) {
-        total += transaction.getTotal();
+Money TransactionController::getTotalRevenue() const {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
+    // Loaded months are in the aggregates, the rest in segments.txt
+    Money revenue = m_aggregates.getOverall().revenue;
+    for (const auto& entry : m_segments) {
+        if (!entry.second.loaded) {
+            revenue += entry.second.revenue;
+        }
     }
-    return total;
+    return revenue;
+}
+
+const SalesAggregates& TransactionController::getAggregates() const {
+    return m_aggregates;
 }
 
 std::vector<Transaction*> TransactionController::getRecent(int count) {
+    std::lock_guard<std::mutex> lock(m_historyMutex);
+
     std::vector<Transaction*> result;
+    if (count <= 0) {
+        return result;
+    }
+
+    loadRecentSegments(static_cast<std::size_t>(count));
 
-    int start = std::max(0, static_cast<int>(m_transactions.size()) - count);
+    int start = std::max(0, static_cast<int>(m_timeIndex.size()) - count);
 
-    for (int i = static_cast<int>(m_transactions.size()) - 1; i >= start; --i) {
-        result.push_back(&m_transactions[i]);
+    for (int i = static_cast<int>(m_timeIndex.size()) - 1; i >= start; --i) {
+        result.push_back(m_transactions.get(m_timeIndex[i].handle));
     }
 
     return result;
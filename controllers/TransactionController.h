@@ -13,8 +13,20 @@
 #include "IController.h"
 #include "../models/Transaction.h"
 #include "../utils/FileManager.h"
+#include "../utils/SlotMap.h"
+#include "../utils/SalesAggregates.h"
+#include "../utils/BinaryIO.h"
+#include "../utils/TransactionArchive.h"
+#include "../utils/IdGenerator.h"
 #include "ProductController.h"
 #include "CustomerController.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 /**
@@ -23,15 +35,392 @@
  *
  * This controller handles the complete transaction flow, including
  * cart management, points calculation, and finalization.
+ *
+ * Each till rings up its own checkout session. Sessions have separate
+ * carts with their own locks, so carts can be built on different threads
+ * at once, and draw transaction IDs from their own leased IdBlock.
+ * Completing a session logs the sale and the customer's new balance under
+ * one history lock, and publishes the balance with a versioned
+ * compare-and-set only once that record is in the log. The
+ * original single-cart methods work on the default session. The product
+ * catalog is read without locking and must not be edited while other
+ * threads are ringing up sales.
+ *
+ * History is kept in monthly segments. Once a month has ended, the next
+ * checkpoint moves it from transactions.txt into transactions-YYYY-MM.txt
+ * and records it in segments.txt. Startup loads only the open month (and
+ * anything not yet sealed). Older months are loaded on demand by getById,
+ * getByCustomerId, getCountByCustomerId, getRecent and the date-range
+ * queries, and then stay loaded. getAll and the aggregates cover only
+ * loaded transactions; getCount and getTotalRevenue add the counts and
+ * totals segments.txt keeps for sealed months that are not loaded.
  */
 class TransactionController : public IController<Transaction> {
 private:
-    std::vector<Transaction> m_transactions;     ///< Completed transactions
-    Transaction m_currentTransaction;            ///< Active cart/transaction
+    /**
+     * @struct TimeEntry
+     * @brief Entry of the date-ordered transaction index
+     */
+    struct TimeEntry {
+        std::int64_t timestamp;  ///< Transaction timestamp
+        SlotHandle handle;       ///< Transaction in m_transactions
+    };
+
+    /**
+     * @struct Segment
+     * @brief A sealed month of history stored in its own file
+     */
+    struct Segment {
+        int count = 0;        ///< Transactions in the segment file
+        int firstId = 0;      ///< Smallest transaction ID in the file
+        int lastId = 0;       ///< Largest transaction ID in the file
+        Money revenue = 0;    ///< Sum of the file's transaction totals
+        bool loaded = false;  ///< The month's transactions are in m_transactions
+        bool dirty = false;   ///< The loaded month differs from the file
+    };
+
+    SlotMap<Transaction> m_transactions;         ///< Completed transactions
+    std::unordered_map<int, SlotHandle> m_index; ///< Transaction ID -> handle in m_transactions
+    std::vector<TimeEntry> m_timeIndex;          ///< All transactions sorted by timestamp
+    std::unordered_map<int, std::vector<SlotHandle>> m_byCustomer;  ///< Customer ID -> transactions, oldest first
+    SalesAggregates m_aggregates;                ///< Running totals over m_transactions
     FileManager& m_fileManager;                  ///< File I/O handler
     ProductController& m_productController;      ///< Product operations
     CustomerController& m_customerController;    ///< Customer operations
+    std::size_t m_logRecordCount;                ///< Records appended since last checkpoint
+    int m_checkpointGeneration;                  ///< Number of background checkpoints begun
+    bool m_checkpointRequired;                   ///< A change reached neither the log nor a checkpoint
+    int m_pendingCheckpoints;                    ///< Background checkpoints not yet finished
+    std::string m_logBuffer;                     ///< Reused serialization buffer for log appends
+    std::unordered_set<std::int64_t> m_archivedMonths;  ///< Closed months (start timestamps) with a current archive
+    std::unordered_map<std::int64_t, std::uint64_t> m_archiveGenerations;  ///< Closed month -> changes to it in this process
+    std::map<std::int64_t, Segment> m_segments;  ///< Sealed months by start timestamp
+    std::int64_t m_sealedUntil;                  ///< Start of the first month not sealed (0 if none are)
     static constexpr const char* FILENAME = "transactions.txt";
+    static constexpr const char* LOG_FILENAME = "transactions.log";
+    static constexpr const char* ROTATED_LOG_FILENAME = "transactions.log.1";  ///< Log awaiting a background checkpoint
+    static constexpr const char* MANIFEST_FILENAME = "segments.txt";  ///< Sealed months and their ID ranges
+    static constexpr std::size_t CHECKPOINT_INTERVAL = 100;  ///< Log records always allowed before a checkpoint
+    static constexpr std::size_t RECORD_SIZE_HINT = 64;  ///< Typical serialized record length
+    static constexpr const char* ARCHIVE_PREFIX = "transactions-";  ///< Archive and segment name is prefix + "YYYY-MM" + extension
+    static constexpr const char* ARCHIVE_EXTENSION = ".col";
+    static constexpr const char* SEGMENT_EXTENSION = ".txt";
+
+    /**
+     * @struct CheckoutSession
+     * @brief One till's cart
+     */
+    struct CheckoutSession {
+        std::mutex mutex;   ///< Guards cart, ids and idEpoch
+        Transaction cart;   ///< Items being rung up
+        IdBlock ids;        ///< Transaction IDs leased for this till
+        int idEpoch = -1;   ///< m_idEpoch when ids was leased
+    };
+
+    std::unordered_map<int, std::shared_ptr<CheckoutSession>> m_sessions;  ///< Open sessions by ID
+    std::shared_ptr<CheckoutSession> m_defaultSession;  ///< Session behind the single-cart API
+    int m_nextSessionId;                         ///< ID for the next openSession()
+    std::atomic<int> m_idEpoch;                  ///< Loads so far; blocks leased before the last one are dropped
+    mutable std::mutex m_sessionsMutex;          ///< Guards m_sessions and m_nextSessionId
+    mutable std::mutex m_historyMutex;           ///< Guards history, indexes and log
+    static constexpr int MAX_POINT_RETRIES = 8;  ///< Balance conflicts tolerated before rejecting
+    static constexpr int ID_BLOCK_SIZE = 64;     ///< Transaction IDs leased per session at a time
+
+    /**
+     * @brief Looks up an open session
+     * @param sessionId Session ID
+     * @return Session (kept alive while held), nullptr if not open
+     */
+    std::shared_ptr<CheckoutSession> findSession(int sessionId) const;
+
+    /**
+     * @brief Empties a cart for the next sale
+     * @param cart Cart to reset
+     * @param customerId Customer for the next sale (0 for guest)
+     */
+    static void resetCart(Transaction& cart, int customerId);
+
+    /**
+     * @brief Leases a fresh block of transaction IDs for a session
+     * @param session Session (its lock held, or not yet shared)
+     */
+    void leaseIds(CheckoutSession& session);
+
+    /**
+     * @brief Takes the next transaction ID from a session's block
+     * @param session Session (its lock and the history lock held)
+     * @param id Receives the ID
+     * @return false only if the ID counter is exhausted
+     *
+     * A block leased before the last load is replaced first: the load may
+     * have brought in IDs above the counter the block was leased from.
+     */
+    bool takeId(CheckoutSession& session, int& id);
+
+    /**
+     * @struct PointsBalance
+     * @brief A customer's balance after a sale, logged in the sale's record
+     */
+    struct PointsBalance {
+        int customerId = 0;         ///< Customer ID (0 when the sale moved no points)
+        int points = 0;             ///< Balance after the sale
+        std::uint32_t version = 0;  ///< Points version after the sale
+    };
+
+    /**
+     * @brief Logs a completed sale and publishes its points (history lock held)
+     * @param sale Sale with its ID and total set
+     * @return true if logged; false if the balance cannot cover the points
+     *         used, kept changing, or the log append failed
+     *
+     * Reads the balance and its version, logs the sale together with the
+     * balance it leaves, and only then sets that balance, provided the
+     * version is unchanged; a conflict retries before anything is logged.
+     * Two tills spending the same points cannot both succeed, and no
+     * balance is ever changed for a sale that is not in the log.
+     */
+    bool logSale(const Transaction& sale);
+
+    /**
+     * @brief Writes a checkpoint and clears the log (history lock held)
+     * @return true if successful
+     */
+    bool writeCheckpoint();
+
+    /**
+     * @brief Moves the log aside so new sales start a fresh one (history lock held)
+     *
+     * The rotated log keeps the sales a background checkpoint is about to
+     * cover until that checkpoint is on disk. If an earlier rotated log is
+     * still waiting, the current records are appended to it instead.
+     */
+    void rotateLog();
+
+    /**
+     * @brief Replays framed records from a log file (history lock held)
+     * @param filename Log file to read
+     *
+     * Records insert or replace by ID and deletions remove, so replaying
+     * records a checkpoint already includes leaves it unchanged.
+     */
+    void replayLog(const std::string& filename);
+
+    /**
+     * @brief Appends a transaction to the history and indexes it
+     * @param transaction Transaction to store (ID must not be present);
+     *        pass an rvalue to move it in without copying its items
+     */
+    void store(Transaction transaction);
+
+    /**
+     * @brief Inserts an entry into the time index, keeping it sorted
+     * @param timestamp Transaction timestamp
+     * @param handle Transaction handle
+     */
+    void indexTime(std::int64_t timestamp, SlotHandle handle);
+
+    /**
+     * @brief Removes an entry from the time index
+     * @param timestamp Transaction timestamp
+     * @param handle Transaction handle
+     */
+    void unindexTime(std::int64_t timestamp, SlotHandle handle);
+
+    /**
+     * @brief Adds a transaction to its customer's posting list, keeping it
+     *        in time order
+     * @param customerId Customer the transaction belongs to
+     * @param handle Transaction handle (already stored)
+     */
+    void indexCustomer(int customerId, SlotHandle handle);
+
+    /**
+     * @brief Removes a transaction from its customer's posting list
+     * @param customerId Customer the transaction belongs to
+     * @param handle Transaction handle
+     */
+    void unindexCustomer(int customerId, SlotHandle handle);
+
+    /**
+     * @brief Fills in product names and prices for a loaded transaction
+     * @param transaction Transaction whose items should be resolved
+     */
+    void resolveItemDetails(Transaction& transaction);
+
+    /**
+     * @brief Replaces a stored transaction, keeping indexes in step (history lock held)
+     * @param handle Handle of the stored transaction
+     * @param transaction New contents (same ID)
+     */
+    void replace(SlotHandle handle, const Transaction& transaction);
+
+    /**
+     * @brief Removes a stored transaction and its index entries (history lock held)
+     * @param id Transaction ID
+     * @return true if found and removed
+     */
+    bool erase(int id);
+
+    /**
+     * @brief Appends a new or changed transaction to the write-ahead log
+     * @param transaction Transaction to log
+     * @param balance Customer balance to log with it (customerId 0 for none)
+     * @return true if the record was written
+     *
+     * The balance shares the transaction's record, so a sale and its
+     * points are either both replayed or both lost.
+     */
+    bool appendToLog(const Transaction& transaction, const PointsBalance& balance);
+
+    /**
+     * @brief Splits a logged balance off the front of a log record
+     * @param record Log record; on success, narrowed to the transaction
+     * @param balance Receives the balance
+     * @return true if the record carried a balance ("+|customer|points|version|...")
+     */
+    static bool parsePointsBalance(std::string_view& record, PointsBalance& balance);
+
+    /**
+     * @brief Appends a transaction deletion to the write-ahead log
+     * @param id ID of the removed transaction
+     * @return true if the record was written
+     */
+    bool appendDeletionToLog(int id);
+
+    /**
+     * @brief Writes m_logBuffer as one log record
+     * @return true if the record was written; if not, the next save is
+     *         made to include a checkpoint
+     */
+    bool writeLogRecord();
+
+    /**
+     * @brief Checks whether the log has grown enough to fold into a checkpoint
+     * @return true once the log holds CHECKPOINT_INTERVAL records and at
+     *         least half as many records as the history (history lock held)
+     */
+    bool checkpointDue() const;
+
+    /**
+     * @brief Rebuilds m_archivedMonths from the archive files on disk
+     *        (history lock held)
+     */
+    void indexArchives();
+
+    /**
+     * @brief Deletes the archive of a timestamp's month, if there is one
+     * @param timestamp Time of a transaction being added, edited or removed
+     *
+     * Called under the history lock so that an archive never disagrees
+     * with the history; the next snapshotArchives() writes it again. The
+     * month's generation moves on too, so an archive of it that was
+     * already queued for writing is recognised as stale when it lands.
+     */
+    void discardArchive(std::int64_t timestamp);
+
+    /**
+     * @brief Opens a month's archive if it is current
+     * @param month Start timestamp of the month
+     * @param archive Receives the opened archive
+     * @return true if the archive is intact and was encoded after the
+     *         month's last change in this process
+     *
+     * An archive from an earlier run is trusted: changes replayed from the
+     * log at startup delete it through discardArchive().
+     */
+    bool openArchive(std::int64_t month, TransactionArchive& archive) const;
+
+    // ============ Monthly Segments (history lock held) ============
+
+    /**
+     * @brief Gets the segment file name for a timestamp's month
+     * @param timestamp Any time within the month
+     * @return "transactions-YYYY-MM.txt"
+     */
+    static std::string segmentFilename(std::int64_t timestamp);
+
+    /**
+     * @brief Reads segments.txt into m_segments and m_sealedUntil
+     */
+    void loadManifest();
+
+    /**
+     * @brief Serializes m_segments and m_sealedUntil
+     * @return segments.txt content
+     */
+    std::string serializeManifest() const;
+
+    /**
+     * @brief Loads a sealed month into memory if it is not loaded yet
+     * @param month Start of the month
+     */
+    void loadSegment(std::int64_t month);
+
+    /**
+     * @brief Sums the transaction totals in a segment file
+     * @param month Start of the month
+     * @return Revenue of the month's file
+     *
+     * Only needed for a segments.txt written before it kept revenue.
+     */
+    Money readSegmentRevenue(std::int64_t month) const;
+
+    /**
+     * @brief Loads sealed months, newest first, until the newest `count`
+     *        transactions are all loaded
+     * @param count Number of transactions wanted
+     */
+    void loadRecentSegments(std::size_t count);
+
+    /**
+     * @brief Loads the sealed months overlapping a time range
+     * @param from First timestamp included
+     * @param to First timestamp excluded
+     */
+    void loadSegmentsInRange(std::int64_t from, std::int64_t to);
+
+    /**
+     * @brief Loads the sealed months whose ID range covers an ID
+     * @param id Transaction ID
+     */
+    void loadSegmentsForId(int id);
+
+    /**
+     * @brief Loads the sealed months that may hold a customer's transactions
+     * @param customerId Customer ID
+     *
+     * A month's columnar archive, when present, is checked first, using
+     * only its CustomerId column, so months without the customer stay on disk.
+     */
+    void loadSegmentsForCustomer(int customerId);
+
+    /**
+     * @brief Prepares a sealed month for a change to one of its transactions
+     * @param timestamp Time of the transaction being added, edited or removed
+     *
+     * Loads the month and marks it dirty so the next checkpoint rewrites
+     * its file. Does nothing for months that are not sealed.
+     */
+    void touchSegment(std::int64_t timestamp);
+
+    /**
+     * @brief Seals ended months and serializes everything a checkpoint writes
+     * @return Dirty segment files, then segments.txt, then transactions.txt
+     *
+     * Written in this order, a crash part-way never loses a month: until
+     * segments.txt is replaced, the old transactions.txt still holds it.
+     */
+    std::vector<PendingFile> serializeCheckpoint();
+
+    /**
+     * @brief Checks whether a checkpoint would seal or rewrite a segment
+     */
+    bool segmentsDue() const;
+
+    /**
+     * @brief Marks every loaded segment dirty after a checkpoint failed
+     */
+    void markLoadedSegmentsDirty();
 
 public:
     /**
@@ -56,9 +445,210 @@ public:
     bool add(const Transaction& transaction) override;
     bool update(const Transaction& transaction) override;
     bool remove(int id) override;
+    int getCount() const override;
+
+    /**
+     * @brief Writes a checkpoint of all unsealed transactions and dirty
+     *        segments, and clears the log
+     * @return true if successful
+     *
+     * Not needed for durability: every add, update and remove is already
+     * in the log. Saving only folds the log into transactions.txt. Save
+     * customers first: the log also holds the balances of logged sales.
+     */
     bool saveToFile() override;
+
+    /**
+     * @brief Loads the unsealed months and replays the log tail after them
+     * @return true if successful
+     *
+     * Sealed months stay on disk until a query needs them.
+     */
     bool loadFromFile() override;
-    int getCount() const override;
+
+    /**
+     * @brief Serializes the history for a background checkpoint
+     * @param generation Receives the number to pass to finishCheckpoint()
+     * @return Files to write in order (see serializeCheckpoint()), ready
+     *         for BackgroundWriter
+     *
+     * The log is rotated at the same moment, so sales completed while the
+     * checkpoint is being written go to a fresh log and are not lost.
+     * Take the customers' changes after this call and write them in the
+     * same batch: the rotated log is the only other copy of the balances
+     * its sales left behind.
+     */
+    std::vector<PendingFile> beginCheckpoint(int& generation);
+
+    /**
+     * @brief Checks whether a save should include a checkpoint
+     * @return true if the log is due for compaction or a change is not yet on disk
+     */
+    bool needsCheckpoint() const;
+
+    /**
+     * @brief Records that a background checkpoint has been written
+     * @param generation Value returned by beginCheckpoint()
+     * @param success Whether the checkpoint file was written
+     *
+     * Safe to call from the writer thread.
+     */
+    void finishCheckpoint(int generation, bool success);
+
+    // ============ Binary Image ============
+
+    /**
+     * @brief Appends the unsealed transactions, oldest first, to a state image payload
+     * @param writer Binary writer
+     */
+    void writeImage(BinaryWriter& writer) const;
+
+    /**
+     * @brief Replaces all transactions with a section written by writeImage()
+     * @param reader Binary reader
+     * @return true if the section was complete (state is undefined otherwise;
+     *         fall back to loadFromFile())
+     */
+    bool readImage(BinaryReader& reader);
+
+    // ============ Columnar Archive ============
+
+    /**
+     * @brief Gets the archive file name for a timestamp's month
+     * @param timestamp Any time within the month
+     * @return "transactions-YYYY-MM.col"
+     */
+    static std::string archiveFilename(std::int64_t timestamp);
+
+    /**
+     * @brief Encodes an archive for every closed month that lacks one
+     * @return Archive files, ready for BackgroundWriter (usually none)
+     *
+     * A month is closed once the current month has begun. Its archive is
+     * rewritten here after any of its transactions is added, edited or
+     * removed.
+     */
+    std::vector<PendingFile> snapshotArchives();
+
+    /**
+     * @brief Forgets which archives are current and checks the disk again
+     *
+     * Call after a failed save, so archives that were not written are
+     * encoded again by the next snapshotArchives().
+     */
+    void scanArchives();
+
+    /**
+     * @brief Sums transaction totals in a time range from the archives
+     * @param from First timestamp included
+     * @param to First timestamp excluded
+     * @return Revenue of the archived transactions in range
+     *
+     * Reads only the Timestamp and Total columns, skips blocks whose
+     * timestamp range lies outside [from, to) and reads only Total for
+     * blocks entirely inside it. Months without an archive contribute 0.
+     */
+    Money getArchivedRevenue(std::int64_t from, std::int64_t to) const;
+
+    // ============ Stable Handles ============
+
+    /**
+     * @brief Gets a stable handle for a transaction
+     * @param id Transaction ID
+     * @return Handle that survives other inserts/removes (null if not found)
+     *
+     * Pointers from getById() and the query methods are only valid until
+     * the history next changes; keep a handle to hold on to a transaction.
+     */
+    SlotHandle getHandle(int id) const;
+
+    /**
+     * @brief Resolves a handle to its transaction
+     * @param handle Handle from getHandle()
+     * @return Pointer to transaction, nullptr if it has since been removed
+     */
+    Transaction* get(SlotHandle handle);
+
+    // ============ Checkout Sessions ============
+
+    static constexpr int DEFAULT_SESSION = 0;  ///< Session used by the single-cart methods
+
+    /**
+     * @brief Opens a new checkout session with an empty cart
+     * @param customerId Customer ID (0 for guest)
+     * @return Session ID
+     */
+    int openSession(int customerId = 0);
+
+    /**
+     * @brief Closes a session, discarding its cart
+     * @param sessionId Session ID (the default session cannot be closed)
+     * @return true if the session was open and is now closed
+     */
+    bool closeSession(int sessionId);
+
+    /**
+     * @brief Gets a copy of a session's cart
+     * @param sessionId Session ID
+     * @return Snapshot of the cart (empty if the session is not open)
+     */
+    Transaction getSessionCart(int sessionId) const;
+
+    /**
+     * @brief Adds a product to a session's cart
+     * @param sessionId Session ID
+     * @param productId Product ID to add
+     * @param quantity Quantity
+     * @return true if session and product found and added
+     */
+    bool addToSessionCart(int sessionId, int productId, int quantity = 1);
+
+    /**
+     * @brief Removes a product from a session's cart
+     * @param sessionId Session ID
+     * @param productId Product ID to remove
+     * @return true if removed
+     */
+    bool removeFromSessionCart(int sessionId, int productId);
+
+    /**
+     * @brief Updates quantity of a product in a session's cart
+     * @param sessionId Session ID
+     * @param productId Product ID
+     * @param quantity New quantity
+     * @return true if updated
+     */
+    bool updateSessionCartQuantity(int sessionId, int productId, int quantity);
+
+    /**
+     * @brief Sets the customer for a session (resets points to use)
+     * @param sessionId Session ID
+     * @param customerId Customer ID
+     * @return true if the session is open
+     */
+    bool setSessionCustomer(int sessionId, int customerId);
+
+    /**
+     * @brief Sets points to use for a session
+     * @param sessionId Session ID
+     * @param points Points to redeem
+     * @return true if customer has enough points
+     */
+    bool setSessionPointsToUse(int sessionId, int points);
+
+    /**
+     * @brief Completes a session's sale and empties its cart
+     * @param sessionId Session ID
+     * @return true if the sale was recorded
+     *
+     * The sale and the customer's new balance are logged in one record
+     * under the history lock, and the balance changes only once that
+     * record is written (see logSale()). A sale that tries to spend points
+     * another till already spent, or that cannot be logged, is rejected
+     * and left in the cart, with the balance untouched and its ID returned
+     * to the session.
+     */
+    bool completeSession(int sessionId);
 
     // ============ Current Transaction (Cart) Operations ============
 
@@ -71,6 +661,9 @@ public:
     /**
      * @brief Gets the current active transaction
      * @return Reference to current transaction
+     *
+     * This is the default session's cart, read without locking; use it
+     * only from the thread that drives the default session.
      */
     Transaction& getCurrentTransaction();
 
@@ -129,7 +722,7 @@ public:
      * 1. Finalize the transaction
      * 2. Deduct loyalty points if used
      * 3. Add earned loyalty points to customer
-     * 4. Add transaction to history
+     * 4. Add transaction to history and append it to the log
      * 5. Clear the cart
      */
     bool completeTransaction();
@@ -150,29 +743,60 @@ public:
     /**
      * @brief Gets transactions for a specific customer
      * @param customerId Customer ID
-     * @return Vector of transactions for that customer
+     * @return Vector of transactions for that customer, oldest first
+     *
+     * Served from a per-customer posting list, so the cost is proportional
+     * to the customer's own history rather than to all transactions.
      */
     std::vector<Transaction*> getByCustomerId(int customerId);
 
+    /**
+     * @brief Gets the number of transactions for a customer
+     * @param customerId Customer ID
+     * @return Transaction count (0 if none)
+     */
+    int getCountByCustomerId(int customerId);
+
     /**
      * @brief Gets transactions for a date range
      * @param startDate Start date (YYYY-MM-DD)
-     * @param endDate End date (YYYY-MM-DD)
-     * @return Vector of transactions in range
+     * @param endDate End date (YYYY-MM-DD), inclusive
+     * @return Vector of transactions in range, oldest first
      */
     std::vector<Transaction*> getByDateRange(const std::string& startDate,
                                               const std::string& endDate);
 
+    /**
+     * @brief Gets transactions in a timestamp range
+     * @param from First timestamp included
+     * @param to First timestamp excluded
+     * @return Vector of transactions in range, oldest first
+     *
+     * Two binary searches over the time index plus a contiguous slice.
+     */
+    std::vector<Transaction*> getByTimeRange(std::int64_t from, std::int64_t to);
+
     /**
      * @brief Calculates total revenue from all transactions
-     * @return Total revenue in IDR
+     * @return Total revenue in IDR, sealed months on disk included
+     */
+    Money getTotalRevenue() const;
+
+    /**
+     * @brief Gets running sales totals by day, hour, product and customer
+     * @return Aggregates kept current as transactions are recorded
+     *
+     * Covers loaded months only (the open month always is); use
+     * getTotalRevenue() and getCount() for all-time totals. Read without
+     * locking; call from the thread that completes sales or while no
+     * other session is completing one.
      */
-    double getTotalRevenue() const;
+    const SalesAggregates& getAggregates() const;
 
     /**
      * @brief Gets recent transactions
      * @param count Number of recent transactions to get
-     * @return Vector of recent transactions
+     * @return Vector of recent transactions, newest first
      */
     std::vector<Transaction*> getRecent(int count);
 };
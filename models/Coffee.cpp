@@ -5,59 +5,66 @@
 
 #include "Coffee.h"
 #include "../utils/FileManager.h"
-#include <sstream>
 
 Coffee::Coffee()
-    : Product()
-    , m_shotSize("single")
+    : Product(ProductType::Coffee)
+    , m_shotSize(TagRegistry::getInstance().intern("single"))
 {
-    m_type = "coffee";
 }
 
-Coffee::Coffee(int id, const std::string& name, double price, const std::string& shotSize)
-    : Product(id, name, price, "coffee")
-    , m_shotSize(shotSize)
+Coffee::Coffee(int id, const std::string& name, Money price, const std::string& shotSize)
+    : Product(id, name, price, ProductType::Coffee)
+    , m_shotSize(TagRegistry::getInstance().intern(shotSize))
 {
 }
 
-std::string Coffee::serialize() const {
-    std::ostringstream oss;
-    oss << m_id << "|" << m_name << "|" << m_price << "|" << m_type << "|" << m_shotSize;
-    return oss.str();
+void Coffee::serializeTo(std::string& buffer) const {
+    FileManager::appendInt(buffer, m_id);
+    buffer += '|';
+    buffer += m_name;
+    buffer += '|';
+    FileManager::appendInt(buffer, m_price);
+    buffer += '|';
+    buffer += typeName(m_type);
+    buffer += '|';
+    buffer += TagRegistry::getInstance().getName(m_shotSize);
 }
 
-void Coffee::deserialize(const std::string& data) {
-    std::vector<std::string> fields = FileManager::splitLine(data, '|');
+void Coffee::deserialize(std::string_view data) {
+    std::string_view fields[5];
+    int id = 0;
+    Money price = 0;
 
-    if (fields.size() >= 5) {
-        m_id = std::stoi(fields[0]);
+    if (FileManager::splitFields(data, '|', fields, 5) >= 5 &&
+        FileManager::parseInt(fields[0], id) &&
+        FileManager::parseMoney(fields[2], price)) {
+        m_id = id;
         m_name = fields[1];
-        m_price = std::stod(fields[2]);
-        m_type = fields[3];
-        m_shotSize = fields[4];
+        m_price = price;
+        m_shotSize = TagRegistry::getInstance().intern(fields[4]);
     }
 }
 
 std::string Coffee::getDescription() const {
-    return m_name + " (" + m_shotSize + " shot)";
+    return m_name + " (" + getShotSize() + " shot)";
 }
 
-std::string Coffee::getExtraField() const {
-    return m_shotSize;
+const std::string& Coffee::getExtraField() const {
+    return getShotSize();
 }
 
 void Coffee::setExtraField(const std::string& value) {
-    m_shotSize = value;
+    setShotSize(value);
 }
 
 Product* Coffee::clone() const {
     return new Coffee(*this);
 }
 
-std::string Coffee::getShotSize() const {
-    return m_shotSize;
+const std::string& Coffee::getShotSize() const {
+    return TagRegistry::getInstance().getName(m_shotSize);
 }
 
 void Coffee::setShotSize(const std::string& size) {
-    m_shotSize = size;
+    m_shotSize = TagRegistry::getInstance().intern(size);
 }
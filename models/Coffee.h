@@ -12,6 +12,7 @@
 #define COFFEE_H
 
 #include "Product.h"
+#include "../utils/TagRegistry.h"
 
 /**
  * @class Coffee
@@ -20,9 +21,9 @@
  * Coffee products have an additional attribute for shot size
  * (single, double) which affects the description.
  */
-class Coffee : public Product {
+class Coffee final : public Product {
 private:
-    std::string m_shotSize;  ///< Shot size: "single", "double"
+    TagRegistry::Tag m_shotSize;  ///< Shot size: "single", "double"
 
 public:
     /**
@@ -37,7 +38,7 @@ public:
      * @param price Price in IDR
      * @param shotSize Shot size ("single" or "double")
      */
-    Coffee(int id, const std::string& name, double price, const std::string& shotSize = "single");
+    Coffee(int id, const std::string& name, Money price, const std::string& shotSize = "single");
 
     /**
      * @brief Virtual destructor
@@ -47,16 +48,16 @@ public:
     // ============ IEntity Interface Implementation ============
 
     /**
-     * @brief Serializes coffee data to CSV format
-     * @return "id|name|price|coffee|shotSize"
+     * @brief Appends coffee data in CSV format
+     * @param buffer Buffer receiving "id|name|price|coffee|shotSize"
      */
-    std::string serialize() const override;
+    void serializeTo(std::string& buffer) const override;
 
     /**
      * @brief Deserializes coffee data from CSV format
      * @param data CSV string in format "id|name|price|coffee|shotSize"
      */
-    void deserialize(const std::string& data) override;
+    void deserialize(std::string_view data) override;
 
     // ============ Product Virtual Methods Override ============
 
@@ -70,7 +71,7 @@ public:
      * @brief Gets the shot size
      * @return Shot size string
      */
-    std::string getExtraField() const override;
+    const std::string& getExtraField() const override;
 
     /**
      * @brief Sets the shot size
@@ -90,7 +91,7 @@ public:
      * @brief Gets the shot size
      * @return "single" or "double"
      */
-    std::string getShotSize() const;
+    const std::string& getShotSize() const;
 
     /**
      * @brief Sets the shot size
@@ -5,13 +5,14 @@
 
 #include "Customer.h"
 #include "../utils/FileManager.h"
-#include <sstream>
+#include "../utils/BinaryIO.h"
 
 Customer::Customer()
     : m_id(0)
     , m_name("")
     , m_phone("")
     , m_loyaltyPoints(0)
+    , m_version(0)
 {
 }
 
@@ -20,6 +21,7 @@ Customer::Customer(int id, const std::string& name, const std::string& phone, in
     , m_name(name)
     , m_phone(phone)
     , m_loyaltyPoints(loyaltyPoints)
+    , m_version(0)
 {
 }
 
@@ -27,23 +29,55 @@ int Customer::getId() const {
     return m_id;
 }
 
-std::string Customer::serialize() const {
-    std::ostringstream oss;
-    oss << m_id << "|" << m_name << "|" << m_phone << "|" << m_loyaltyPoints;
-    return oss.str();
-}
-
-void Customer::deserialize(const std::string& data) {
-    std::vector<std::string> fields = FileManager::splitLine(data, '|');
-
-    if (fields.size() >= 4) {
-        m_id = std::stoi(fields[0]);
+void Customer::serializeTo(std::string& buffer) const {
+    FileManager::appendInt(buffer, m_id);
+    buffer += '|';
+    buffer += m_name;
+    buffer += '|';
+    buffer += m_phone;
+    buffer += '|';
+    FileManager::appendInt(buffer, m_loyaltyPoints);
+    buffer += '|';
+    FileManager::appendInt(buffer, m_version);
+}
+
+void Customer::deserialize(std::string_view data) {
+    std::string_view fields[5];
+    int id = 0;
+    int points = 0;
+    std::uint32_t version = 0;
+
+    // The points version was added later; older files have four fields
+    std::size_t count = FileManager::splitFields(data, '|', fields, 5);
+    if (count >= 4 &&
+        FileManager::parseInt(fields[0], id) &&
+        FileManager::parseInt(fields[3], points) &&
+        (count < 5 || FileManager::parseUInt32(fields[4], version))) {
+        m_id = id;
         m_name = fields[1];
         m_phone = fields[2];
-        m_loyaltyPoints = std::stoi(fields[3]);
+        m_loyaltyPoints = points;
+        m_version = version;
     }
 }
 
+void Customer::writeBinary(BinaryWriter& writer) const {
+    writer.put(m_id);
+    writer.putString(m_name);
+    writer.putString(m_phone);
+    writer.put(m_loyaltyPoints);
+    writer.put(m_version);
+}
+
+bool Customer::readBinary(BinaryReader& reader) {
+    m_id = reader.get<int>();
+    m_name = reader.getString();
+    m_phone = reader.getString();
+    m_loyaltyPoints = reader.get<int>();
+    m_version = reader.get<std::uint32_t>();
+    return reader.ok();
+}
+
 bool Customer::isValid() const {
     return m_id > 0 && !m_name.empty();
 }
@@ -60,6 +94,10 @@ int Customer::getLoyaltyPoints() const {
     return m_loyaltyPoints;
 }
 
+std::uint32_t Customer::getVersion() const {
+    return m_version;
+}
+
 void Customer::setId(int id) {
     m_id = id;
 }
@@ -73,26 +111,39 @@ void Customer::setPhone(const std::string& phone) {
 }
 
 void Customer::setLoyaltyPoints(int points) {
-    if (points >= 0) {
+    if (points >= 0 && points != m_loyaltyPoints) {
         m_loyaltyPoints = points;
+        ++m_version;
     }
 }
 
+void Customer::restorePoints(int points, std::uint32_t version) {
+    m_loyaltyPoints = points;
+    m_version = version;
+}
+
+void Customer::commitPoints(int points) {
+    m_loyaltyPoints = points;
+    ++m_version;
+}
+
 void Customer::addPoints(int points) {
     if (points > 0) {
         m_loyaltyPoints += points;
+        ++m_version;
     }
 }
 
 bool Customer::redeemPoints(int points) {
     if (canRedeemPoints(points)) {
         m_loyaltyPoints -= points;
+        ++m_version;
         return true;
     }
     return false;
 }
 
-int Customer::calculatePointsForAmount(double amount) {
+int Customer::calculatePointsForAmount(Money amount) {
     if (amount <= 0) {
         return 0;
     }
@@ -100,14 +151,18 @@ int Customer::calculatePointsForAmount(double amount) {
     return static_cast<int>(amount / POINTS_PER_UNIT);
 }
 
-double Customer::calculatePointsValue(int points) {
+Money Customer::calculatePointsValue(int points) {
     if (points <= 0) {
-        return 0.0;
+        return 0;
     }
     // Each point is worth 100 IDR
-    return points * POINT_VALUE;
+    return static_cast<Money>(points) * POINT_VALUE;
 }
 
 bool Customer::canRedeemPoints(int points) const {
-    return points >= MIN_REDEEM_POINTS && points <= m_loyaltyPoints;
+    return canRedeemFrom(m_loyaltyPoints, points);
+}
+
+bool Customer::canRedeemFrom(int balance, int points) {
+    return points >= MIN_REDEEM_POINTS && points <= balance;
 }
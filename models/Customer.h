@@ -14,8 +14,13 @@
 #define CUSTOMER_H
 
 #include "IEntity.h"
+#include "../utils/Money.h"
+#include <cstdint>
 #include <string>
 
+class BinaryWriter;
+class BinaryReader;
+
 /**
  * @class Customer
  * @brief Represents a customer in the loyalty program
@@ -29,6 +34,7 @@ private:
     std::string m_name;       ///< Customer name
     std::string m_phone;      ///< Phone number
     int m_loyaltyPoints;      ///< Current loyalty points balance
+    std::uint32_t m_version;  ///< Bumped on every points change; replay keeps the newest
 
 public:
     // ============ Constants ============
@@ -58,13 +64,33 @@ public:
      */
     virtual ~Customer() = default;
 
+    Customer(const Customer&) = default;
+    Customer(Customer&&) noexcept = default;
+    Customer& operator=(const Customer&) = default;
+    Customer& operator=(Customer&&) noexcept = default;
+
     // ============ IEntity Interface Implementation ============
 
     int getId() const override;
-    std::string serialize() const override;
-    void deserialize(const std::string& data) override;
+    void serializeTo(std::string& buffer) const override;
+    void deserialize(std::string_view data) override;
     bool isValid() const override;
 
+    // ============ Binary Image ============
+
+    /**
+     * @brief Appends this customer in the state image format
+     * @param writer Binary writer
+     */
+    void writeBinary(BinaryWriter& writer) const;
+
+    /**
+     * @brief Reads a customer written by writeBinary()
+     * @param reader Binary reader
+     * @return true if the record was complete
+     */
+    bool readBinary(BinaryReader& reader);
+
     // ============ Getters ============
 
     /**
@@ -85,6 +111,12 @@ public:
      */
     int getLoyaltyPoints() const;
 
+    /**
+     * @brief Gets the points version
+     * @return Counter that changes whenever the points balance changes
+     */
+    std::uint32_t getVersion() const;
+
     // ============ Setters ============
 
     /**
@@ -111,6 +143,22 @@ public:
      */
     void setLoyaltyPoints(int points);
 
+    /**
+     * @brief Sets the balance and version read back from a log
+     * @param points Logged points balance
+     * @param version Points version that balance was written under
+     */
+    void restorePoints(int points, std::uint32_t version);
+
+    /**
+     * @brief Sets the balance as a new version, even if the value is unchanged
+     * @param points New points balance
+     *
+     * Every compare-and-set must move the version on, so a write read
+     * before it can never land afterwards.
+     */
+    void commitPoints(int points);
+
     // ============ Loyalty Points Operations ============
 
     /**
@@ -131,14 +179,14 @@ public:
      * @param amount Transaction amount in IDR
      * @return Number of points earned
      */
-    static int calculatePointsForAmount(double amount);
+    static int calculatePointsForAmount(Money amount);
 
     /**
      * @brief Calculates the IDR value of points
      * @param points Number of points
      * @return Value in IDR
      */
-    static double calculatePointsValue(int points);
+    static Money calculatePointsValue(int points);
 
     /**
      * @brief Checks if points can be redeemed
@@ -146,6 +194,14 @@ public:
      * @return true if enough points available
      */
     bool canRedeemPoints(int points) const;
+
+    /**
+     * @brief Checks if points can be redeemed from a given balance
+     * @param balance Points balance
+     * @param points Points to check
+     * @return true if the redemption meets the minimum and fits the balance
+     */
+    static bool canRedeemFrom(int balance, int points);
 };
 
 #endif // CUSTOMER_H
@@ -15,6 +15,7 @@
 #define IENTITY_H
 
 #include <string>
+#include <string_view>
 
 /**
  * @class IEntity
@@ -44,15 +45,29 @@ public:
      * The format uses '|' as delimiter:
      * id|field1|field2|...
      */
-    virtual std::string serialize() const = 0;
+    virtual std::string serialize() const {
+        std::string buffer;
+        serializeTo(buffer);
+        return buffer;
+    }
+
+    /**
+     * @brief Appends the CSV-format record to a caller-owned buffer
+     * @param buffer Buffer to append to (existing content is kept)
+     *
+     * Numbers are written with std::to_chars, so values round-trip exactly
+     * and a whole dataset can be serialized into one reused buffer.
+     */
+    virtual void serializeTo(std::string& buffer) const = 0;
 
     /**
      * @brief Deserializes data from a CSV-format string
      * @param data String representation from file
      *
      * Parses the '|' delimited string and populates entity fields.
+     * Takes a view so records can be parsed straight out of a mapped file.
      */
-    virtual void deserialize(const std::string& data) = 0;
+    virtual void deserialize(std::string_view data) = 0;
 
     /**
      * @brief Checks if the entity is valid
@@ -4,16 +4,17 @@
  */
 
 #include "Product.h"
+#include "../utils/BinaryIO.h"
 
-Product::Product()
+Product::Product(ProductType type)
     : m_id(0)
     , m_name("")
-    , m_price(0.0)
-    , m_type("")
+    , m_price(0)
+    , m_type(type)
 {
 }
 
-Product::Product(int id, const std::string& name, double price, const std::string& type)
+Product::Product(int id, const std::string& name, Money price, ProductType type)
     : m_id(id)
     , m_name(name)
     , m_price(price)
@@ -29,18 +30,53 @@ bool Product::isValid() const {
     return m_id > 0 && !m_name.empty() && m_price >= 0;
 }
 
+void Product::writeBinary(BinaryWriter& writer) const {
+    writer.put(m_id);
+    writer.putString(m_name);
+    writer.put(m_price);
+    writer.putString(getExtraField());
+}
+
+bool Product::readBinary(BinaryReader& reader) {
+    m_id = reader.get<int>();
+    m_name = reader.getString();
+    m_price = reader.get<Money>();
+    setExtraField(std::string(reader.getString()));
+    return reader.ok();
+}
+
 std::string Product::getName() const {
     return m_name;
 }
 
-double Product::getPrice() const {
+Money Product::getPrice() const {
     return m_price;
 }
 
-std::string Product::getType() const {
+const std::string& Product::getType() const {
+    return typeName(m_type);
+}
+
+ProductType Product::getProductType() const {
     return m_type;
 }
 
+const std::string& Product::typeName(ProductType type) {
+    static const std::string names[PRODUCT_TYPE_COUNT] = {"coffee", "snack"};
+    return names[static_cast<std::size_t>(type)];
+}
+
+bool Product::parseType(std::string_view name, ProductType& type) {
+    if (name == "coffee") {
+        type = ProductType::Coffee;
+    } else if (name == "snack") {
+        type = ProductType::Snack;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 void Product::setId(int id) {
     m_id = id;
 }
@@ -49,15 +85,15 @@ void Product::setName(const std::string& name) {
     m_name = name;
 }
 
-void Product::setPrice(double price) {
+void Product::setPrice(Money price) {
     if (price >= 0) {
         m_price = price;
     }
 }
 
-double Product::calculatePrice(int quantity) const {
+Money Product::calculatePrice(int quantity) const {
     if (quantity <= 0) {
-        return 0.0;
+        return 0;
     }
     return m_price * quantity;
 }
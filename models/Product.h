@@ -16,7 +16,24 @@
 #define PRODUCT_H
 
 #include "IEntity.h"
+#include "../utils/Money.h"
+#include <cstddef>
 #include <string>
+#include <string_view>
+
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * @enum ProductType
+ * @brief Tag identifying the concrete product class
+ */
+enum class ProductType {
+    Coffee,
+    Snack
+};
+
+constexpr std::size_t PRODUCT_TYPE_COUNT = 2;  ///< Number of ProductType values
 
 /**
  * @class Product
@@ -30,14 +47,15 @@ class Product : public IEntity {
 protected:
     int m_id;              ///< Unique product identifier
     std::string m_name;    ///< Product name
-    double m_price;        ///< Price in IDR
-    std::string m_type;    ///< Product type ("coffee" or "snack")
+    Money m_price;         ///< Price in IDR
+    ProductType m_type;    ///< Product type, fixed by the derived class
 
 public:
     /**
      * @brief Default constructor
+     * @param type Product type
      */
-    Product();
+    explicit Product(ProductType type);
 
     /**
      * @brief Parameterized constructor
@@ -46,7 +64,7 @@ public:
      * @param price Price in IDR
      * @param type Product type
      */
-    Product(int id, const std::string& name, double price, const std::string& type);
+    Product(int id, const std::string& name, Money price, ProductType type);
 
     /**
      * @brief Virtual destructor
@@ -60,6 +78,24 @@ public:
 
     // serialize() and deserialize() are implemented by derived classes
 
+    // ============ Binary Image ============
+
+    /**
+     * @brief Appends this product in the state image format
+     * @param writer Binary writer
+     *
+     * The type is not written; callers record it so they can construct
+     * the right derived class before calling readBinary().
+     */
+    void writeBinary(BinaryWriter& writer) const;
+
+    /**
+     * @brief Reads a product written by writeBinary()
+     * @param reader Binary reader
+     * @return true if the record was complete
+     */
+    bool readBinary(BinaryReader& reader);
+
     // ============ Getters ============
 
     /**
@@ -72,13 +108,36 @@ public:
      * @brief Gets the product price
      * @return Price in IDR
      */
-    double getPrice() const;
+    Money getPrice() const;
 
     /**
      * @brief Gets the product type
      * @return "coffee" or "snack"
      */
-    std::string getType() const;
+    const std::string& getType() const;
+
+    /**
+     * @brief Gets the product type tag
+     * @return Product type
+     */
+    ProductType getProductType() const;
+
+    // ============ Type Names ============
+
+    /**
+     * @brief Gets the name used for a type in files and the UI
+     * @param type Product type
+     * @return "coffee" or "snack"
+     */
+    static const std::string& typeName(ProductType type);
+
+    /**
+     * @brief Parses a type name
+     * @param name "coffee" or "snack"
+     * @param type Receives the type on success
+     * @return true if the name is known
+     */
+    static bool parseType(std::string_view name, ProductType& type);
 
     // ============ Setters ============
 
@@ -98,7 +157,7 @@ public:
      * @brief Sets the product price
      * @param price New price in IDR
      */
-    void setPrice(double price);
+    void setPrice(Money price);
 
     // ============ Virtual Methods (Polymorphism) ============
 
@@ -117,13 +176,13 @@ public:
      *
      * Virtual with default implementation - can be overridden
      */
-    virtual double calculatePrice(int quantity) const;
+    virtual Money calculatePrice(int quantity) const;
 
     /**
      * @brief Gets the extra field value specific to product type
      * @return Extra field value (e.g., shot size for coffee, category for snack)
      */
-    virtual std::string getExtraField() const = 0;
+    virtual const std::string& getExtraField() const = 0;
 
     /**
      * @brief Sets the extra field value specific to product type
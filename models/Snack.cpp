@@ -5,59 +5,66 @@
 
 #include "Snack.h"
 #include "../utils/FileManager.h"
-#include <sstream>
 
 Snack::Snack()
-    : Product()
-    , m_category("other")
+    : Product(ProductType::Snack)
+    , m_category(TagRegistry::getInstance().intern("other"))
 {
-    m_type = "snack";
 }
 
-Snack::Snack(int id, const std::string& name, double price, const std::string& category)
-    : Product(id, name, price, "snack")
-    , m_category(category)
+Snack::Snack(int id, const std::string& name, Money price, const std::string& category)
+    : Product(id, name, price, ProductType::Snack)
+    , m_category(TagRegistry::getInstance().intern(category))
 {
 }
 
-std::string Snack::serialize() const {
-    std::ostringstream oss;
-    oss << m_id << "|" << m_name << "|" << m_price << "|" << m_type << "|" << m_category;
-    return oss.str();
+void Snack::serializeTo(std::string& buffer) const {
+    FileManager::appendInt(buffer, m_id);
+    buffer += '|';
+    buffer += m_name;
+    buffer += '|';
+    FileManager::appendInt(buffer, m_price);
+    buffer += '|';
+    buffer += typeName(m_type);
+    buffer += '|';
+    buffer += TagRegistry::getInstance().getName(m_category);
 }
 
-void Snack::deserialize(const std::string& data) {
-    std::vector<std::string> fields = FileManager::splitLine(data, '|');
+void Snack::deserialize(std::string_view data) {
+    std::string_view fields[5];
+    int id = 0;
+    Money price = 0;
 
-    if (fields.size() >= 5) {
-        m_id = std::stoi(fields[0]);
+    if (FileManager::splitFields(data, '|', fields, 5) >= 5 &&
+        FileManager::parseInt(fields[0], id) &&
+        FileManager::parseMoney(fields[2], price)) {
+        m_id = id;
         m_name = fields[1];
-        m_price = std::stod(fields[2]);
-        m_type = fields[3];
-        m_category = fields[4];
+        m_price = price;
+        m_category = TagRegistry::getInstance().intern(fields[4]);
     }
 }
 
 std::string Snack::getDescription() const {
-    return m_name + " [" + m_category + "]";
+    return m_name + " [" + getCategory() + "]";
 }
 
-std::string Snack::getExtraField() const {
-    return m_category;
+const std::string& Snack::getExtraField() const {
+    return getCategory();
 }
 
 void Snack::setExtraField(const std::string& value) {
-    m_category = value;
+    setCategory(value);
 }
 
 Product* Snack::clone() const {
     return new Snack(*this);
 }
 
-std::string Snack::getCategory() const {
-    return m_category;
+const std::string& Snack::getCategory() const {
+    return TagRegistry::getInstance().getName(m_category);
 }
 
 void Snack::setCategory(const std::string& category) {
-    m_category = category;
+    m_category = TagRegistry::getInstance().intern(category);
 }
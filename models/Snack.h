@@ -12,6 +12,7 @@
 #define SNACK_H
 
 #include "Product.h"
+#include "../utils/TagRegistry.h"
 
 /**
  * @class Snack
@@ -20,9 +21,9 @@
  * Snack products have an additional attribute for category
  * (pastry, sandwich, other) which helps classify the item.
  */
-class Snack : public Product {
+class Snack final : public Product {
 private:
-    std::string m_category;  ///< Category: "pastry", "sandwich", "other"
+    TagRegistry::Tag m_category;  ///< Category: "pastry", "sandwich", "other"
 
 public:
     /**
@@ -37,7 +38,7 @@ public:
      * @param price Price in IDR
      * @param category Category ("pastry", "sandwich", "other")
      */
-    Snack(int id, const std::string& name, double price, const std::string& category = "other");
+    Snack(int id, const std::string& name, Money price, const std::string& category = "other");
 
     /**
      * @brief Virtual destructor
@@ -47,16 +48,16 @@ public:
     // ============ IEntity Interface Implementation ============
 
     /**
-     * @brief Serializes snack data to CSV format
-     * @return "id|name|price|snack|category"
+     * @brief Appends snack data in CSV format
+     * @param buffer Buffer receiving "id|name|price|snack|category"
      */
-    std::string serialize() const override;
+    void serializeTo(std::string& buffer) const override;
 
     /**
      * @brief Deserializes snack data from CSV format
      * @param data CSV string in format "id|name|price|snack|category"
      */
-    void deserialize(const std::string& data) override;
+    void deserialize(std::string_view data) override;
 
     // ============ Product Virtual Methods Override ============
 
@@ -70,7 +71,7 @@ public:
      * @brief Gets the category
      * @return Category string
      */
-    std::string getExtraField() const override;
+    const std::string& getExtraField() const override;
 
     /**
      * @brief Sets the category
@@ -90,7 +91,7 @@ public:
      * @brief Gets the snack category
      * @return "pastry", "sandwich", or "other"
      */
-    std::string getCategory() const;
+    const std::string& getCategory() const;
 
     /**
      * @brief Sets the snack category
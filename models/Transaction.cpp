@@ -6,18 +6,18 @@
 #include "Transaction.h"
 #include "Customer.h"
 #include "../utils/FileManager.h"
-#include <sstream>
-#include <chrono>
-#include <iomanip>
+#include "../utils/DateTime.h"
+#include "../utils/BinaryIO.h"
 #include <algorithm>
 
 Transaction::Transaction()
     : m_id(0)
     , m_customerId(0)
-    , m_dateTime("")
-    , m_subtotal(0.0)
-    , m_discount(0.0)
-    , m_total(0.0)
+    , m_timestamp(0)
+    , m_itemCount(0)
+    , m_subtotal(0)
+    , m_discount(0)
+    , m_total(0)
     , m_pointsEarned(0)
     , m_pointsUsed(0)
 {
@@ -26,10 +26,11 @@ Transaction::Transaction()
 Transaction::Transaction(int id, int customerId)
     : m_id(id)
     , m_customerId(customerId)
-    , m_dateTime("")
-    , m_subtotal(0.0)
-    , m_discount(0.0)
-    , m_total(0.0)
+    , m_timestamp(0)
+    , m_itemCount(0)
+    , m_subtotal(0)
+    , m_discount(0)
+    , m_total(0)
     , m_pointsEarned(0)
     , m_pointsUsed(0)
 {
@@ -40,28 +41,44 @@ int Transaction::getId() const {
     return m_id;
 }
 
-std::string Transaction::serialize() const {
-    std::ostringstream oss;
-    oss << m_id << "|"
-        << m_customerId << "|"
-        << m_dateTime << "|"
-        << std::fixed << std::setprecision(0) << m_total << "|"
-        << m_pointsEarned << "|"
-        << m_pointsUsed << "|"
-        << serializeItems();
-    return oss.str();
-}
-
-void Transaction::deserialize(const std::string& data) {
-    std::vector<std::string> fields = FileManager::splitLine(data, '|');
-
-    if (fields.size() >= 7) {
-        m_id = std::stoi(fields[0]);
-        m_customerId = std::stoi(fields[1]);
-        m_dateTime = fields[2];
-        m_total = std::stod(fields[3]);
-        m_pointsEarned = std::stoi(fields[4]);
-        m_pointsUsed = std::stoi(fields[5]);
+void Transaction::serializeTo(std::string& buffer) const {
+    FileManager::appendInt(buffer, m_id);
+    buffer += '|';
+    FileManager::appendInt(buffer, m_customerId);
+    buffer += '|';
+    DateTime::formatTo(buffer, m_timestamp);
+    buffer += '|';
+    FileManager::appendInt(buffer, m_total);
+    buffer += '|';
+    FileManager::appendInt(buffer, m_pointsEarned);
+    buffer += '|';
+    FileManager::appendInt(buffer, m_pointsUsed);
+    buffer += '|';
+    serializeItemsTo(buffer);
+}
+
+void Transaction::deserialize(std::string_view data) {
+    std::string_view fields[7];
+    int id = 0;
+    int customerId = 0;
+    Money total = 0;
+    int pointsEarned = 0;
+    int pointsUsed = 0;
+    std::int64_t timestamp = 0;
+
+    if (FileManager::splitFields(data, '|', fields, 7) >= 7 &&
+        FileManager::parseInt(fields[0], id) &&
+        FileManager::parseInt(fields[1], customerId) &&
+        DateTime::parse(fields[2], timestamp) &&
+        FileManager::parseMoney(fields[3], total) &&
+        FileManager::parseInt(fields[4], pointsEarned) &&
+        FileManager::parseInt(fields[5], pointsUsed)) {
+        m_id = id;
+        m_customerId = customerId;
+        m_timestamp = timestamp;
+        m_total = total;
+        m_pointsEarned = pointsEarned;
+        m_pointsUsed = pointsUsed;
         deserializeItems(fields[6]);
 
         // Recalculate discount from points used
@@ -70,6 +87,52 @@ void Transaction::deserialize(const std::string& data) {
     }
 }
 
+void Transaction::writeBinary(BinaryWriter& writer) const {
+    writer.put(m_id);
+    writer.put(m_customerId);
+    writer.put(m_timestamp);
+    writer.put(m_total);
+    writer.put(m_pointsEarned);
+    writer.put(m_pointsUsed);
+
+    // Names and prices come from the catalog on load, as with the text format
+    writer.put(static_cast<std::uint32_t>(m_items.size()));
+    for (const auto& item : m_items) {
+        writer.put(item.getProductId());
+        writer.put(item.getQuantity());
+    }
+}
+
+bool Transaction::readBinary(BinaryReader& reader) {
+    m_id = reader.get<int>();
+    m_customerId = reader.get<int>();
+    m_timestamp = reader.get<std::int64_t>();
+    m_total = reader.get<Money>();
+    m_pointsEarned = reader.get<int>();
+    m_pointsUsed = reader.get<int>();
+
+    std::uint32_t itemCount = reader.get<std::uint32_t>();
+    m_items.clear();
+    m_lineIndex.clear();
+    m_itemCount = 0;
+    m_items.reserve(itemCount);
+
+    // Lines were merged by product before they were written; findLine()
+    // indexes them if the transaction is ever edited
+    for (std::uint32_t i = 0; i < itemCount && reader.ok(); ++i) {
+        TransactionItem item;
+        item.setProductId(reader.get<int>());
+        item.setQuantity(reader.get<int>());
+        m_itemCount += item.getQuantity();
+        m_items.push_back(std::move(item));
+    }
+
+    // Recalculate discount from points used
+    m_discount = Customer::calculatePointsValue(m_pointsUsed);
+    m_subtotal = m_total + m_discount;
+    return reader.ok();
+}
+
 bool Transaction::isValid() const {
     return m_id > 0 && !m_items.empty();
 }
@@ -79,22 +142,26 @@ int Transaction::getCustomerId() const {
 }
 
 std::string Transaction::getDateTime() const {
-    return m_dateTime;
+    return DateTime::format(m_timestamp);
+}
+
+std::int64_t Transaction::getTimestamp() const {
+    return m_timestamp;
 }
 
 const std::vector<TransactionItem>& Transaction::getItems() const {
     return m_items;
 }
 
-double Transaction::getSubtotal() const {
+Money Transaction::getSubtotal() const {
     return m_subtotal;
 }
 
-double Transaction::getDiscount() const {
+Money Transaction::getDiscount() const {
     return m_discount;
 }
 
-double Transaction::getTotal() const {
+Money Transaction::getTotal() const {
     return m_total;
 }
 
@@ -107,11 +174,7 @@ int Transaction::getPointsUsed() const {
 }
 
 int Transaction::getItemCount() const {
-    int count = 0;
-    for (const auto& item : m_items) {
-        count += item.getQuantity();
-    }
-    return count;
+    return m_itemCount;
 }
 
 void Transaction::setId(int id) {
@@ -123,70 +186,111 @@ void Transaction::setCustomerId(int customerId) {
 }
 
 void Transaction::setDateTime(const std::string& dateTime) {
-    m_dateTime = dateTime;
+    DateTime::parse(dateTime, m_timestamp);
+}
+
+void Transaction::setTimestamp(std::int64_t timestamp) {
+    m_timestamp = timestamp;
 }
 
 void Transaction::setPointsUsed(int points) {
     if (points >= 0) {
         m_pointsUsed = points;
-        recalculate();
+        updateTotals();
     }
 }
 
 void Transaction::addItem(const TransactionItem& item) {
+    if (item.getQuantity() <= 0) {
+        return;
+    }
+
     // Check if product already exists
-    for (auto& existingItem : m_items) {
-        if (existingItem.getProductId() == item.getProductId()) {
-            existingItem.incrementQuantity(item.getQuantity());
-            recalculate();
-            return;
-        }
+    std::size_t position = findLine(item.getProductId());
+    if (position < m_items.size()) {
+        TransactionItem& existingItem = m_items[position];
+        existingItem.incrementQuantity(item.getQuantity());
+        m_subtotal += existingItem.getUnitPrice() * item.getQuantity();
+    } else {
+        // Add new item
+        m_lineIndex[item.getProductId()] = m_items.size();
+        m_items.push_back(item);
+        m_subtotal += item.getSubtotal();
     }
 
-    // Add new item
-    m_items.push_back(item);
-    recalculate();
+    m_itemCount += item.getQuantity();
+    updateTotals();
 }
 
 bool Transaction::removeItem(int productId) {
-    auto it = std::find_if(m_items.begin(), m_items.end(),
-        [productId](const TransactionItem& item) {
-            return item.getProductId() == productId;
-        });
-
-    if (it != m_items.end()) {
-        m_items.erase(it);
-        recalculate();
-        return true;
+    std::size_t position = findLine(productId);
+    if (position == m_items.size()) {
+        return false;
+    }
+
+    m_subtotal -= m_items[position].getSubtotal();
+    m_itemCount -= m_items[position].getQuantity();
+
+    // Keep cart order; only lines after the removed one move
+    m_lineIndex.erase(productId);
+    m_items.erase(m_items.begin() + static_cast<std::ptrdiff_t>(position));
+    for (std::size_t i = position; i < m_items.size(); ++i) {
+        m_lineIndex[m_items[i].getProductId()] = i;
     }
-    return false;
+
+    updateTotals();
+    return true;
 }
 
 bool Transaction::updateItemQuantity(int productId, int quantity) {
-    for (auto& item : m_items) {
-        if (item.getProductId() == productId) {
-            if (quantity <= 0) {
-                return removeItem(productId);
+    std::size_t position = findLine(productId);
+    if (position == m_items.size()) {
+        return false;
+    }
+    if (quantity <= 0) {
+        return removeItem(productId);
+    }
+
+    TransactionItem& item = m_items[position];
+    int change = quantity - item.getQuantity();
+    item.setQuantity(quantity);
+    m_subtotal += item.getUnitPrice() * change;
+    m_itemCount += change;
+
+    updateTotals();
+    return true;
+}
+
+const TransactionItem* Transaction::getItem(int productId) const {
+    if (m_lineIndex.empty()) {
+        // Not indexed yet (see findLine); scan rather than mutate in a const call
+        for (const auto& item : m_items) {
+            if (item.getProductId() == productId) {
+                return &item;
             }
-            item.setQuantity(quantity);
-            recalculate();
-            return true;
         }
+        return nullptr;
     }
-    return false;
+
+    auto it = m_lineIndex.find(productId);
+    return (it != m_lineIndex.end()) ? &m_items[it->second] : nullptr;
 }
 
-TransactionItem* Transaction::getItem(int productId) {
-    for (auto& item : m_items) {
-        if (item.getProductId() == productId) {
-            return &item;
+std::size_t Transaction::findLine(int productId) {
+    if (m_lineIndex.empty()) {
+        for (std::size_t i = 0; i < m_items.size(); ++i) {
+            m_lineIndex[m_items[i].getProductId()] = i;
         }
     }
-    return nullptr;
+
+    auto it = m_lineIndex.find(productId);
+    return (it != m_lineIndex.end()) ? it->second : m_items.size();
 }
 
 void Transaction::clearItems() {
     m_items.clear();
+    m_lineIndex.clear();
+    m_itemCount = 0;
     recalculate();
 }
 
@@ -196,11 +300,15 @@ bool Transaction::hasItems() const {
 
 void Transaction::recalculate() {
     // Calculate subtotal
-    m_subtotal = 0.0;
+    m_subtotal = 0;
     for (const auto& item : m_items) {
         m_subtotal += item.getSubtotal();
     }
 
+    updateTotals();
+}
+
+void Transaction::updateTotals() {
     // Calculate discount from points
     m_discount = Customer::calculatePointsValue(m_pointsUsed);
 
@@ -221,43 +329,64 @@ int Transaction::calculatePointsEarned() const {
 }
 
 void Transaction::setCurrentDateTime() {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    std::ostringstream oss;
-    oss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
-    m_dateTime = oss.str();
+    m_timestamp = DateTime::now();
 }
 
-std::string Transaction::serializeItems() const {
-    if (m_items.empty()) {
-        return "";
-    }
-
-    std::ostringstream oss;
+void Transaction::serializeItemsTo(std::string& buffer) const {
     for (size_t i = 0; i < m_items.size(); ++i) {
         if (i > 0) {
-            oss << ",";
+            buffer += ',';
         }
-        oss << m_items[i].serializeCompact();
+        m_items[i].serializeCompactTo(buffer);
     }
-    return oss.str();
 }
 
-void Transaction::deserializeItems(const std::string& data) {
+void Transaction::deserializeItems(std::string_view data) {
     m_items.clear();
+    m_lineIndex.clear();
+    m_itemCount = 0;
 
     if (data.empty()) {
         return;
     }
 
-    // Split by comma
-    std::vector<std::string> itemStrings = FileManager::splitLine(data, ',');
+    // Walk the comma-separated entries in place
+    std::size_t start = 0;
+    while (start <= data.size()) {
+        auto end = data.find(',', start);
+        if (end == std::string_view::npos) {
+            end = data.size();
+        }
 
-    for (const auto& itemStr : itemStrings) {
         TransactionItem item;
-        item.deserializeCompact(itemStr);
+        item.deserializeCompact(data.substr(start, end - start));
         if (item.getProductId() > 0) {
-            m_items.push_back(item);
+            // Saved lines are already merged by product, so a short scan is
+            // enough to catch duplicates in old or hand-edited rows; only a
+            // long row gets m_lineIndex built here, through findLine()
+            std::size_t position = m_items.size();
+            if (m_items.size() <= MERGE_SCAN_MAX) {
+                for (std::size_t i = 0; i < m_items.size(); ++i) {
+                    if (m_items[i].getProductId() == item.getProductId()) {
+                        position = i;
+                        break;
+                    }
+                }
+            } else {
+                position = findLine(item.getProductId());
+            }
+
+            if (position < m_items.size()) {
+                m_items[position].incrementQuantity(item.getQuantity());
+            } else {
+                if (!m_lineIndex.empty()) {
+                    m_lineIndex[item.getProductId()] = m_items.size();
+                }
+                m_items.push_back(item);
+            }
+            m_itemCount += item.getQuantity();
         }
+
+        start = end + 1;
     }
 }
@@ -12,28 +12,53 @@
 
 #include "IEntity.h"
 #include "TransactionItem.h"
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
+class BinaryWriter;
+class BinaryReader;
+
 /**
  * @class Transaction
  * @brief Represents a complete sales transaction
  *
  * A transaction contains multiple items, customer information,
  * and loyalty points data. It calculates totals and manages
- * the points earned/used.
+ * the points earned/used. Cart edits adjust the totals by the
+ * changed line only, so their cost does not grow with the cart.
  */
 class Transaction : public IEntity {
 private:
     int m_id;                              ///< Unique transaction identifier
     int m_customerId;                      ///< Customer ID (0 for guest)
-    std::string m_dateTime;                ///< Transaction date/time
+    std::int64_t m_timestamp;              ///< Transaction date/time (see DateTime)
     std::vector<TransactionItem> m_items;  ///< Items in the transaction
-    double m_subtotal;                     ///< Total before discount
-    double m_discount;                     ///< Discount from points
-    double m_total;                        ///< Final total after discount
+    std::unordered_map<int, std::size_t> m_lineIndex;  ///< Product ID -> position in m_items (built on first edit or for long rows)
+    int m_itemCount;                       ///< Sum of item quantities
+    Money m_subtotal;                      ///< Total before discount
+    Money m_discount;                      ///< Discount from points
+    Money m_total;                         ///< Final total after discount
     int m_pointsEarned;                    ///< Points earned from this transaction
     int m_pointsUsed;                      ///< Points redeemed in this transaction
+    static constexpr std::size_t MERGE_SCAN_MAX = 16;  ///< Longest row deserializeItems() merges without m_lineIndex
+
+    /**
+     * @brief Derives discount, total and points earned from the subtotal
+     */
+    void updateTotals();
+
+    /**
+     * @brief Finds the line for a product, building m_lineIndex if needed
+     * @param productId Product ID
+     * @return Position in m_items, or m_items.size() if absent
+     *
+     * History loaded from the text files or the state image is rarely
+     * edited, so its index is left empty until the first edit instead of
+     * built per transaction.
+     */
+    std::size_t findLine(int productId);
 
 public:
     /**
@@ -53,21 +78,53 @@ public:
      */
     virtual ~Transaction() = default;
 
+    // Moves are not implicit once the destructor is declared
+    Transaction(const Transaction&) = default;
+    Transaction(Transaction&&) noexcept = default;
+    Transaction& operator=(const Transaction&) = default;
+    Transaction& operator=(Transaction&&) noexcept = default;
+
     // ============ IEntity Interface Implementation ============
 
     int getId() const override;
-    std::string serialize() const override;
-    void deserialize(const std::string& data) override;
+    void serializeTo(std::string& buffer) const override;
+    void deserialize(std::string_view data) override;
     bool isValid() const override;
 
+    // ============ Binary Image ============
+
+    /**
+     * @brief Appends this transaction in the state image format
+     * @param writer Binary writer
+     */
+    void writeBinary(BinaryWriter& writer) const;
+
+    /**
+     * @brief Reads a transaction written by writeBinary()
+     * @param reader Binary reader
+     * @return true if the record was complete
+     */
+    bool readBinary(BinaryReader& reader);
+
     // ============ Getters ============
 
     int getCustomerId() const;
+
+    /**
+     * @brief Gets the date/time formatted for display
+     * @return "YYYY-MM-DD HH:MM:SS"
+     */
     std::string getDateTime() const;
+
+    /**
+     * @brief Gets the date/time as an integer timestamp
+     * @return Seconds since 1970-01-01 00:00:00 local time
+     */
+    std::int64_t getTimestamp() const;
     const std::vector<TransactionItem>& getItems() const;
-    double getSubtotal() const;
-    double getDiscount() const;
-    double getTotal() const;
+    Money getSubtotal() const;
+    Money getDiscount() const;
+    Money getTotal() const;
     int getPointsEarned() const;
     int getPointsUsed() const;
     int getItemCount() const;
@@ -76,7 +133,18 @@ public:
 
     void setId(int id);
     void setCustomerId(int customerId);
+
+    /**
+     * @brief Sets the date/time from text
+     * @param dateTime "YYYY-MM-DD HH:MM:SS" (ignored if invalid)
+     */
     void setDateTime(const std::string& dateTime);
+
+    /**
+     * @brief Sets the date/time as an integer timestamp
+     * @param timestamp Seconds since 1970-01-01 00:00:00 local time
+     */
+    void setTimestamp(std::int64_t timestamp);
     void setPointsUsed(int points);
 
     // ============ Item Management ============
@@ -108,8 +176,11 @@ public:
      * @brief Gets an item by product ID
      * @param productId Product ID to find
      * @return Pointer to item, nullptr if not found
+     *
+     * Read-only so quantities can only change through the methods above,
+     * which keep the totals in step.
      */
-    TransactionItem* getItem(int productId);
+    const TransactionItem* getItem(int productId) const;
 
     /**
      * @brief Clears all items from the transaction
@@ -127,8 +198,9 @@ public:
     /**
      * @brief Recalculates all totals
      *
-     * Updates subtotal, discount, total, and points earned
-     * based on current items and points used.
+     * Re-sums the subtotal from the items, then updates discount, total,
+     * and points earned. Item edits keep the totals current on their own;
+     * this is for checkout and after item prices are changed directly.
      */
     void recalculate();
 
@@ -146,16 +218,16 @@ public:
     // ============ Serialization Helpers ============
 
     /**
-     * @brief Serializes items to compact format
-     * @return "productId:qty,productId:qty,..." format
+     * @brief Appends items in compact format
+     * @param buffer Buffer receiving "productId:qty,productId:qty,..."
      */
-    std::string serializeItems() const;
+    void serializeItemsTo(std::string& buffer) const;
 
     /**
      * @brief Deserializes items from compact format
      * @param data Items string in compact format
      */
-    void deserializeItems(const std::string& data);
+    void deserializeItems(std::string_view data);
 };
 
 #endif // TRANSACTION_H
@@ -5,17 +5,16 @@
 
 #include "TransactionItem.h"
 #include "../utils/FileManager.h"
-#include <sstream>
 
 TransactionItem::TransactionItem()
     : m_productId(0)
     , m_productName("")
-    , m_unitPrice(0.0)
+    , m_unitPrice(0)
     , m_quantity(0)
 {
 }
 
-TransactionItem::TransactionItem(int productId, const std::string& productName, double unitPrice, int quantity)
+TransactionItem::TransactionItem(int productId, const std::string& productName, Money unitPrice, int quantity)
     : m_productId(productId)
     , m_productName(productName)
     , m_unitPrice(unitPrice)
@@ -31,7 +30,7 @@ std::string TransactionItem::getProductName() const {
     return m_productName;
 }
 
-double TransactionItem::getUnitPrice() const {
+Money TransactionItem::getUnitPrice() const {
     return m_unitPrice;
 }
 
@@ -39,7 +38,7 @@ int TransactionItem::getQuantity() const {
     return m_quantity;
 }
 
-double TransactionItem::getSubtotal() const {
+Money TransactionItem::getSubtotal() const {
     return m_unitPrice * m_quantity;
 }
 
@@ -51,7 +50,7 @@ void TransactionItem::setProductName(const std::string& name) {
     m_productName = name;
 }
 
-void TransactionItem::setUnitPrice(double price) {
+void TransactionItem::setUnitPrice(Money price) {
     if (price >= 0) {
         m_unitPrice = price;
     }
@@ -77,16 +76,21 @@ bool TransactionItem::decrementQuantity(int amount) {
     return false;
 }
 
-std::string TransactionItem::serializeCompact() const {
-    std::ostringstream oss;
-    oss << m_productId << ":" << m_quantity;
-    return oss.str();
+void TransactionItem::serializeCompactTo(std::string& buffer) const {
+    FileManager::appendInt(buffer, m_productId);
+    buffer += ':';
+    FileManager::appendInt(buffer, m_quantity);
 }
 
-void TransactionItem::deserializeCompact(const std::string& data) {
-    std::vector<std::string> parts = FileManager::splitLine(data, ':');
-    if (parts.size() >= 2) {
-        m_productId = std::stoi(parts[0]);
-        m_quantity = std::stoi(parts[1]);
+void TransactionItem::deserializeCompact(std::string_view data) {
+    std::string_view parts[2];
+    int productId = 0;
+    int quantity = 0;
+
+    if (FileManager::splitFields(data, ':', parts, 2) >= 2 &&
+        FileManager::parseInt(parts[0], productId) &&
+        FileManager::parseInt(parts[1], quantity)) {
+        m_productId = productId;
+        m_quantity = quantity;
     }
 }
@@ -9,7 +9,9 @@
 #ifndef TRANSACTIONITEM_H
 #define TRANSACTIONITEM_H
 
+#include "../utils/Money.h"
 #include <string>
+#include <string_view>
 
 /**
  * @class TransactionItem
@@ -22,7 +24,7 @@ class TransactionItem {
 private:
     int m_productId;          ///< Product ID reference
     std::string m_productName; ///< Product name (stored for history)
-    double m_unitPrice;        ///< Price per unit at time of purchase
+    Money m_unitPrice;         ///< Price per unit at time of purchase
     int m_quantity;            ///< Number of units
 
 public:
@@ -38,26 +40,26 @@ public:
      * @param unitPrice Price per unit
      * @param quantity Number of units
      */
-    TransactionItem(int productId, const std::string& productName, double unitPrice, int quantity);
+    TransactionItem(int productId, const std::string& productName, Money unitPrice, int quantity);
 
     // ============ Getters ============
 
     int getProductId() const;
     std::string getProductName() const;
-    double getUnitPrice() const;
+    Money getUnitPrice() const;
     int getQuantity() const;
 
     /**
      * @brief Calculates subtotal for this item
      * @return unitPrice * quantity
      */
-    double getSubtotal() const;
+    Money getSubtotal() const;
 
     // ============ Setters ============
 
     void setProductId(int id);
     void setProductName(const std::string& name);
-    void setUnitPrice(double price);
+    void setUnitPrice(Money price);
     void setQuantity(int qty);
 
     /**
@@ -76,16 +78,16 @@ public:
     // ============ Serialization ============
 
     /**
-     * @brief Serializes to compact format for transaction storage
-     * @return "productId:quantity"
+     * @brief Appends compact format for transaction storage
+     * @param buffer Buffer receiving "productId:quantity"
      */
-    std::string serializeCompact() const;
+    void serializeCompactTo(std::string& buffer) const;
 
     /**
      * @brief Deserializes from compact format
      * @param data "productId:quantity" format
      */
-    void deserializeCompact(const std::string& data);
+    void deserializeCompact(std::string_view data);
 };
 
 #endif // TRANSACTIONITEM_H
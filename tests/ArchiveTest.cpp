@@ -0,0 +1,61 @@
+/**
+ * @file ArchiveTest.cpp
+ * @brief Columnar archives: one encoded before its month changed is never
+ *        taken as current, even when its write lands late
+ */
+
+#include "TestSupport.h"
+#include "../utils/DateTime.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+void testLateArchiveWriteIsStale() {
+    std::string dir = TestSupport::scratchDirectory("archive-late-write");
+    FileManager fileManager(dir);
+    fileManager.writeLines("products.txt", {"1|Espresso|18000|coffee|single"});
+
+    std::int64_t lastMonth = DateTime::startOfMonth(DateTime::startOfMonth(DateTime::now()) - 1);
+    std::int64_t nextMonth = DateTime::startOfNextMonth(lastMonth);
+    Transaction edited = TestSupport::makeSale(1, lastMonth + 3600, 3);
+    {
+        Store store(fileManager);
+        CHECK(store.transactions.add(TestSupport::makeSale(1, lastMonth + 3600, 1)));
+
+        // A save takes the archive, then the sale changes before it is written
+        std::vector<PendingFile> queued = store.transactions.snapshotArchives();
+        CHECK(queued.size() == 1);
+        CHECK(store.transactions.update(edited));
+        CHECK(TestSupport::writeAll(fileManager, queued));
+
+        // Rescanning after a failed save must not pick the stale file up
+        store.transactions.scanArchives();
+        CHECK(store.transactions.getArchivedRevenue(lastMonth, nextMonth) == 0);
+
+        std::vector<PendingFile> rewritten = store.transactions.snapshotArchives();
+        CHECK(rewritten.size() == 1);
+        CHECK(TestSupport::writeAll(fileManager, rewritten));
+        CHECK(store.transactions.getArchivedRevenue(lastMonth, nextMonth) == edited.getTotal());
+
+        // The stale write lands again, now over the current archive
+        CHECK(TestSupport::writeAll(fileManager, queued));
+        CHECK(store.transactions.getArchivedRevenue(lastMonth, nextMonth) == 0);
+        // Crash before the next save
+    }
+
+    // The edit replayed from the log drops the archive left behind
+    Store store(fileManager);
+    CHECK(store.transactions.getArchivedRevenue(lastMonth, nextMonth) == 0);
+    std::vector<PendingFile> rewritten = store.transactions.snapshotArchives();
+    CHECK(rewritten.size() == 1);
+    CHECK(TestSupport::writeAll(fileManager, rewritten));
+    CHECK(store.transactions.getArchivedRevenue(lastMonth, nextMonth) == edited.getTotal());
+}
+
+} // namespace
+
+int main() {
+    testLateArchiveWriteIsStale();
+    return TestSupport::finish("ArchiveTest");
+}
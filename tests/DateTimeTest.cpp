@@ -0,0 +1,52 @@
+/**
+ * @file DateTimeTest.cpp
+ * @brief Date parsing: days are checked against the month's real length
+ */
+
+#include "TestSupport.h"
+#include "../utils/DateTime.h"
+#include <cstdint>
+
+namespace {
+
+bool parses(const char* text) {
+    std::int64_t timestamp = 0;
+    return DateTime::parse(text, timestamp);
+}
+
+void testMonthLengths() {
+    CHECK(parses("2025-01-31"));
+    CHECK(parses("2025-04-30 23:59:59"));
+    CHECK(!parses("2025-04-31"));
+    CHECK(!parses("2025-06-31 10:00:00"));
+    CHECK(!parses("2025-09-31"));
+    CHECK(!parses("2025-11-31"));
+    CHECK(!parses("2025-02-30"));
+    CHECK(!parses("2025-00-10"));
+    CHECK(!parses("2025-13-10"));
+    CHECK(!parses("2025-05-00"));
+}
+
+void testLeapYears() {
+    CHECK(parses("2024-02-29"));
+    CHECK(parses("2000-02-29 12:00:00"));
+    CHECK(!parses("2025-02-29"));
+    CHECK(!parses("1900-02-29"));
+    CHECK(!parses("2024-02-30"));
+}
+
+void testRoundTrip() {
+    std::int64_t timestamp = 0;
+    CHECK(DateTime::parse("2024-02-29 08:15:30", timestamp));
+    CHECK(DateTime::format(timestamp) == "2024-02-29 08:15:30");
+    CHECK(DateTime::format(timestamp + DateTime::SECONDS_PER_DAY) == "2024-03-01 08:15:30");
+}
+
+} // namespace
+
+int main() {
+    testMonthLengths();
+    testLeapYears();
+    testRoundTrip();
+    return TestSupport::finish("DateTimeTest");
+}
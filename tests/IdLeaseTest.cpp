@@ -0,0 +1,155 @@
+/**
+ * @file IdLeaseTest.cpp
+ * @brief Leased ID blocks: unique across threads and sessions, never
+ *        reissued after a reload, never past INT_MAX
+ */
+
+#include "TestSupport.h"
+#include "../utils/BinaryIO.h"
+#include "../utils/IdGenerator.h"
+#include <algorithm>
+#include <climits>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int THREADS = 8;
+constexpr int BLOCKS_PER_THREAD = 500;
+constexpr int BLOCK_SIZE = 16;
+
+void testBlocksFromManyThreads() {
+    IdGenerator& ids = IdGenerator::getInstance();
+    ids.resetAll();
+
+    std::vector<std::vector<int>> taken(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&ids, &taken, t]() {
+            for (int i = 0; i < BLOCKS_PER_THREAD; ++i) {
+                IdBlock block = ids.leaseBlock(EntityType::Transaction, BLOCK_SIZE);
+                int id = 0;
+                while (block.take(id)) {
+                    taken[t].push_back(id);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<int> all;
+    for (const auto& list : taken) {
+        all.insert(all.end(), list.begin(), list.end());
+    }
+    std::sort(all.begin(), all.end());
+    CHECK(all.size() == static_cast<std::size_t>(THREADS * BLOCKS_PER_THREAD * BLOCK_SIZE));
+    CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+    CHECK(all.front() == 1 && all.back() == static_cast<int>(all.size()));
+}
+
+void testReloadNeverGoesBackwards() {
+    std::string dir = TestSupport::scratchDirectory("id-lease-reload");
+    FileManager fileManager(dir);
+    IdGenerator& ids = IdGenerator::getInstance();
+    ids.resetAll();
+
+    // A block still in use when the counters are saved
+    IdBlock open = ids.leaseBlock(EntityType::Transaction, BLOCK_SIZE);
+    int first = 0;
+    CHECK(open.take(first));
+    CHECK(ids.saveToFile(fileManager));
+    std::string image;
+    BinaryWriter writer(image);
+    ids.writeImage(writer);
+
+    ids.resetAll();
+    CHECK(ids.loadFromFile(fileManager));
+    IdBlock next = ids.leaseBlock(EntityType::Transaction, BLOCK_SIZE);
+    CHECK(next.next >= open.end);
+
+    ids.resetAll();
+    BinaryReader reader(image);
+    CHECK(ids.readImage(reader));
+    next = ids.leaseBlock(EntityType::Transaction, BLOCK_SIZE);
+    CHECK(next.next >= open.end);
+}
+
+void testNoOverflow() {
+    IdGenerator& ids = IdGenerator::getInstance();
+    ids.resetAll();
+    ids.updateCounter(EntityType::Transaction, INT_MAX - 10);
+
+    IdBlock block = ids.leaseBlock(EntityType::Transaction, 100);
+    CHECK(block.next == INT_MAX - 9 && block.end == INT_MAX);
+    CHECK(ids.getCurrentCounter(EntityType::Transaction) == INT_MAX - 1);
+
+    IdBlock exhausted = ids.leaseBlock(EntityType::Transaction, 100);
+    int id = 0;
+    CHECK(!exhausted.take(id));
+    CHECK(ids.getCurrentCounter(EntityType::Transaction) == INT_MAX - 1);
+}
+
+void testSessionsDrawFromBlocks() {
+    std::string dir = TestSupport::scratchDirectory("id-lease-sessions");
+    FileManager fileManager(dir);
+    fileManager.writeLines("products.txt", {"1|Espresso|18000|coffee|single"});
+    IdGenerator::getInstance().resetAll();
+
+    constexpr int SALES = 200;
+    std::set<int> saved;
+    {
+        Store store(fileManager);
+        TransactionController& transactions = store.transactions;
+
+        std::vector<std::thread> tills;
+        for (int t = 0; t < 4; ++t) {
+            int session = transactions.openSession();
+            tills.emplace_back([&transactions, session]() {
+                for (int i = 0; i < SALES; ++i) {
+                    transactions.addToSessionCart(session, 1, 1);
+                    transactions.completeSession(session);
+                }
+            });
+        }
+        for (auto& till : tills) {
+            till.join();
+        }
+
+        for (const auto& sale : transactions.getAll()) {
+            saved.insert(sale.getId());
+        }
+        CHECK(saved.size() == 4 * SALES);
+    }
+
+    // After a restart, new sessions lease above everything in the log
+    IdGenerator::getInstance().resetAll();
+    Store store(fileManager);
+    TransactionController& transactions = store.transactions;
+    CHECK(transactions.getCount() == 4 * SALES);
+
+    int session = transactions.openSession();
+    CHECK(transactions.addToSessionCart(session, 1, 1));
+    CHECK(transactions.completeSession(session));
+
+    std::vector<int> added;
+    for (const auto& sale : transactions.getAll()) {
+        if (saved.count(sale.getId()) == 0) {
+            added.push_back(sale.getId());
+        }
+    }
+    CHECK(added.size() == 1 && added[0] > *saved.rbegin());
+}
+
+} // namespace
+
+int main() {
+    testBlocksFromManyThreads();
+    testReloadNeverGoesBackwards();
+    testNoOverflow();
+    testSessionsDrawFromBlocks();
+    return TestSupport::finish("IdLeaseTest");
+}
@@ -0,0 +1,112 @@
+/**
+ * @file JournalCompactionTest.cpp
+ * @brief Journal compaction: a crash between the table and the journal reset
+ */
+
+#include "TestSupport.h"
+#include "../utils/FileManager.h"
+#include "../controllers/CustomerController.h"
+#include "../controllers/ProductController.h"
+#include <string>
+
+namespace {
+
+// Writes the files of a save, stopping after the first `limit` of them
+void writeFiles(const FileManager& fileManager, const std::vector<PendingFile>& files,
+                std::size_t limit) {
+    for (std::size_t i = 0; i < files.size() && i < limit; ++i) {
+        if (files[i].append) {
+            fileManager.appendBuffer(files[i].filename, files[i].data);
+        } else {
+            fileManager.writeBuffer(files[i].filename, files[i].data);
+        }
+    }
+}
+
+void testCustomerCrashAfterTableWrite() {
+    std::string dir = TestSupport::scratchDirectory("customer-compaction");
+    FileManager fileManager(dir);
+    fileManager.writeLines("customers.txt", {"1|Budi|0811|100", "2|Sari|0812|50"});
+
+    {
+        CustomerController customers(fileManager);
+        customers.loadFromFile();
+
+        // Name v2 goes to the journal
+        customers.update(Customer(1, "Budi v2", "0811", 100));
+        writeFiles(fileManager, customers.snapshotChanges(), 2);
+
+        // Name v3 is only in the compacted table: the journal reset is lost
+        customers.update(Customer(1, "Budi v3", "0811", 100));
+        customers.requireFullSave();
+        std::vector<PendingFile> files = customers.snapshotChanges();
+        CHECK(files.size() == 2);
+        writeFiles(fileManager, files, 1);
+    }
+
+    CustomerController customers(fileManager);
+    customers.loadFromFile();
+    CHECK(customers.getById(1) && customers.getById(1)->getName() == "Budi v3");
+
+    // The stale journal was replaced, so new deltas survive the next load
+    customers.update(Customer(2, "Sari v2", "0812", 50));
+    writeFiles(fileManager, customers.snapshotChanges(), 1);
+
+    CustomerController reloaded(fileManager);
+    reloaded.loadFromFile();
+    CHECK(reloaded.getById(1) && reloaded.getById(1)->getName() == "Budi v3");
+    CHECK(reloaded.getById(2) && reloaded.getById(2)->getName() == "Sari v2");
+}
+
+void testProductCrashAfterTableWrite() {
+    std::string dir = TestSupport::scratchDirectory("product-compaction");
+    FileManager fileManager(dir);
+    fileManager.writeLines("products.txt", {"1|Espresso|18000|coffee|single"});
+
+    {
+        ProductController products(fileManager);
+        products.loadFromFile();
+
+        Coffee espresso(1, "Espresso", 19000, "single");
+        products.update(espresso);
+        writeFiles(fileManager, products.snapshotChanges(), 1);
+
+        espresso.setPrice(21000);
+        products.update(espresso);
+        products.requireFullSave();
+        writeFiles(fileManager, products.snapshotChanges(), 1);
+    }
+
+    ProductController products(fileManager);
+    products.loadFromFile();
+    CHECK(products.getById(1) && products.getById(1)->getPrice() == 21000);
+}
+
+void testCompletedCompactionKeepsJournal() {
+    std::string dir = TestSupport::scratchDirectory("completed-compaction");
+    FileManager fileManager(dir);
+    fileManager.writeLines("customers.txt", {"1|Budi|0811|100"});
+
+    {
+        CustomerController customers(fileManager);
+        customers.loadFromFile();
+        customers.requireFullSave();
+        writeFiles(fileManager, customers.snapshotChanges(), 2);
+
+        customers.update(Customer(1, "Budi v2", "0811", 100));
+        writeFiles(fileManager, customers.snapshotChanges(), 1);
+    }
+
+    CustomerController customers(fileManager);
+    customers.loadFromFile();
+    CHECK(customers.getById(1) && customers.getById(1)->getName() == "Budi v2");
+}
+
+} // namespace
+
+int main() {
+    testCustomerCrashAfterTableWrite();
+    testProductCrashAfterTableWrite();
+    testCompletedCompactionKeepsJournal();
+    return TestSupport::finish("JournalCompactionTest");
+}
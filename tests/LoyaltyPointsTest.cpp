@@ -0,0 +1,151 @@
+/**
+ * @file LoyaltyPointsTest.cpp
+ * @brief Loyalty points: durable with the sale, untouched by customer edits
+ */
+
+#include "TestSupport.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+void prepare(FileManager& fileManager) {
+    fileManager.writeLines("products.txt", {"1|Espresso|18000|coffee|single"});
+    fileManager.writeLines("customers.txt", {"1|Budi|0811|100"});
+}
+
+// Rings up two espressos for a customer, redeeming pointsUsed
+bool sell(Store& store, int customerId, int pointsUsed) {
+    store.transactions.startNewTransaction(customerId);
+    store.transactions.addToCart(1, 2);
+    if (pointsUsed > 0 && !store.transactions.setPointsToUse(pointsUsed)) {
+        return false;
+    }
+    return store.transactions.completeTransaction();
+}
+
+void testSalePointsSurviveCrash() {
+    std::string dir = TestSupport::scratchDirectory("points-crash");
+    FileManager fileManager(dir);
+    prepare(fileManager);
+
+    int balance = 0;
+    {
+        Store store(fileManager);
+        CHECK(sell(store, 1, 50));
+        balance = store.customers.getLoyaltyPoints(1);
+        CHECK(balance != 100);
+        // Crash: customers.txt is never saved
+    }
+
+    {
+        Store store(fileManager);
+        CHECK(store.customers.getLoyaltyPoints(1) == balance);
+        CHECK(store.customers.saveToFile());
+    }
+
+    // Replaying the same sale over the saved balance changes nothing, and
+    // a newer balance saved since is not rolled back to the logged one
+    {
+        Store store(fileManager);
+        CHECK(store.customers.getLoyaltyPoints(1) == balance);
+        CHECK(store.customers.addLoyaltyPoints(1, 5));
+        CHECK(store.customers.saveToFile());
+    }
+
+    Store store(fileManager);
+    CHECK(store.customers.getLoyaltyPoints(1) == balance + 5);
+}
+
+void testEditKeepsPoints() {
+    std::string dir = TestSupport::scratchDirectory("points-edit");
+    FileManager fileManager(dir);
+    prepare(fileManager);
+
+    Store store(fileManager);
+    Customer stale = *store.customers.getById(1);
+    CHECK(sell(store, 1, 0));
+    int balance = store.customers.getLoyaltyPoints(1);
+
+    // A form opened before the sale still holds the old balance
+    stale.setName("Budi v2");
+    CHECK(store.customers.update(stale));
+    CHECK(store.customers.getById(1)->getName() == "Budi v2");
+    CHECK(store.customers.getLoyaltyPoints(1) == balance);
+}
+
+// Largest transaction ID in memory
+int lastSaleId(Store& store) {
+    int id = 0;
+    for (const auto& sale : store.transactions.getAll()) {
+        id = std::max(id, sale.getId());
+    }
+    return id;
+}
+
+void testFailedLogAppendRejectsSale() {
+    std::string dir = TestSupport::scratchDirectory("points-append-failure");
+    FileManager fileManager(dir);
+    prepare(fileManager);
+
+    Store store(fileManager);
+    CHECK(sell(store, 1, 0));
+    int count = store.transactions.getCount();
+    int firstId = lastSaleId(store);
+    int points = 0;
+    std::uint32_t version = 0;
+    CHECK(store.customers.readLoyaltyPoints(1, points, version));
+
+    // A directory in the log's place makes every append fail
+    std::filesystem::remove(dir + "transactions.log");
+    std::filesystem::create_directory(dir + "transactions.log");
+
+    // The balance is never touched, not even for a moment, and the
+    // sale's ID goes back to the till
+    CHECK(!sell(store, 1, 50));
+    int pointsAfter = 0;
+    std::uint32_t versionAfter = 0;
+    CHECK(store.customers.readLoyaltyPoints(1, pointsAfter, versionAfter));
+    CHECK(pointsAfter == points);
+    CHECK(versionAfter == version);
+    CHECK(store.transactions.getCount() == count);
+    CHECK(store.transactions.hasItemsInCart());
+
+    std::filesystem::remove(dir + "transactions.log");
+    CHECK(store.transactions.completeTransaction());
+    CHECK(lastSaleId(store) == firstId + 1);
+    CHECK(store.customers.getLoyaltyPoints(1) != points);
+}
+
+void testEqualWriteMovesVersion() {
+    std::string dir = TestSupport::scratchDirectory("points-equal-write");
+    FileManager fileManager(dir);
+    prepare(fileManager);
+
+    Store store(fileManager);
+    int points = 0;
+    std::uint32_t read = 0;
+    CHECK(store.customers.readLoyaltyPoints(1, points, read));
+
+    // Writing the balance it already has still takes a new version
+    std::uint32_t version = read;
+    CHECK(store.customers.compareAndSetLoyaltyPoints(1, version, points));
+    CHECK(version != read);
+
+    // so a writer still holding the first read cannot land after it
+    std::uint32_t stale = read;
+    CHECK(!store.customers.compareAndSetLoyaltyPoints(1, stale, points - 10));
+    CHECK(store.customers.getLoyaltyPoints(1) == points);
+}
+
+} // namespace
+
+int main() {
+    testSalePointsSurviveCrash();
+    testEditKeepsPoints();
+    testFailedLogAppendRejectsSale();
+    testEqualWriteMovesVersion();
+    return TestSupport::finish("LoyaltyPointsTest");
+}
@@ -0,0 +1,112 @@
+/**
+ * @file MoneyRoundTripTest.cpp
+ * @brief Integer money: totals and files are bit-identical after a
+ *        save -> load -> save cycle
+ */
+
+#include "TestSupport.h"
+#include "../utils/DateTime.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int SALES = 20000;
+const char* const FILES[] = {"products.txt", "customers.txt", "transactions.txt"};
+
+// Reads the saved tables, minus the generation header every rewrite bumps
+std::vector<std::string> readFiles(const FileManager& fileManager) {
+    std::vector<std::string> contents;
+    for (const char* filename : FILES) {
+        std::string data(fileManager.mapFile(filename).data());
+        if (data.rfind("# generation|", 0) == 0) {
+            data.erase(0, data.find('\n') + 1);
+        }
+        contents.push_back(std::move(data));
+    }
+    return contents;
+}
+
+void testSaveLoadSaveIsBitIdentical() {
+    std::string dir = TestSupport::scratchDirectory("money-round-trip");
+    FileManager fileManager(dir);
+    fileManager.writeLines("products.txt", {
+        "1|Espresso|18000|coffee|single",
+        "2|Latte|27500|coffee|double",
+        "3|Croissant|22000|snack|pastry",
+        "4|Cookie|9500|snack|baked",
+    });
+    fileManager.writeLines("customers.txt", {"1|Budi|0811|100000", "2|Sari|0812|0"});
+
+    Money expected = 0;
+    Money reported = 0;
+    std::vector<std::string> saved;
+    {
+        Store store(fileManager);
+        std::int64_t month = DateTime::startOfMonth(DateTime::now());
+
+        // Odd quantities and point discounts, so totals are not round numbers
+        for (int i = 1; i <= SALES; ++i) {
+            Transaction sale;
+            sale.setId(i);
+            sale.setCustomerId(i % 3);
+            sale.setTimestamp(month + i);
+            for (int productId : {1 + i % 4, 1 + (i + 1) % 4}) {
+                const Product* product = store.products.getById(productId);
+                sale.addItem(TransactionItem(productId, product->getName(), product->getPrice(),
+                                             1 + (i + productId) % 7));
+            }
+            if (sale.getCustomerId() == 1 && i % 5 == 0) {
+                sale.setPointsUsed(10 + i % 40);
+            }
+            sale.recalculate();
+
+            expected += sale.getTotal();
+            CHECK(store.transactions.add(sale));
+        }
+
+        reported = store.transactions.getTotalRevenue();
+        CHECK(reported == expected);
+        CHECK(store.save());
+        saved = readFiles(fileManager);
+    }
+
+    Store store(fileManager);
+    CHECK(store.transactions.getCount() == SALES);
+    CHECK(store.transactions.getTotalRevenue() == reported);
+
+    Money reloaded = 0;
+    for (const Transaction* sale : store.transactions.getByTimeRange(0, INT64_MAX)) {
+        reloaded += sale->getTotal();
+    }
+    CHECK(reloaded == expected);
+
+    CHECK(store.save());
+    std::vector<std::string> resaved = readFiles(fileManager);
+    for (std::size_t i = 0; i < saved.size(); ++i) {
+        CHECK(!saved[i].empty() && saved[i] == resaved[i]);
+    }
+}
+
+void testLegacyDecimalPricesRound() {
+    std::string dir = TestSupport::scratchDirectory("money-legacy");
+    FileManager fileManager(dir);
+    fileManager.writeLines("products.txt", {
+        "1|Espresso|1e+05|coffee|single",
+        "2|Croissant|18500.6|snack|pastry",
+    });
+
+    Store store(fileManager);
+    CHECK(store.products.getById(1) && store.products.getById(1)->getPrice() == 100000);
+    CHECK(store.products.getById(2) && store.products.getById(2)->getPrice() == 18501);
+}
+
+} // namespace
+
+int main() {
+    testSaveLoadSaveIsBitIdentical();
+    testLegacyDecimalPricesRound();
+    return TestSupport::finish("MoneyRoundTripTest");
+}
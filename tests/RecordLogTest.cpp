@@ -0,0 +1,120 @@
+/**
+ * @file RecordLogTest.cpp
+ * @brief Framed record logs: torn tails, byte-exact payloads and replay
+ */
+
+#include "TestSupport.h"
+#include "../utils/FileManager.h"
+#include "../controllers/ProductController.h"
+#include "../controllers/CustomerController.h"
+#include "../controllers/TransactionController.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Appends raw bytes, bypassing FileManager, as a crash part-way would leave them
+void appendRaw(const std::string& path, const std::string& bytes) {
+    std::ofstream file(path, std::ios::app | std::ios::binary);
+    file << bytes;
+}
+
+void testTornTailIsTruncated() {
+    std::string dir = TestSupport::scratchDirectory("torn-tail");
+    FileManager fileManager(dir);
+
+    CHECK(fileManager.appendRecord("test.log", "first"));
+    std::string frame;
+    FileManager::frameRecord(frame, "second record");
+    appendRaw(dir + "test.log", frame.substr(0, frame.size() / 2));
+
+    CHECK(fileManager.readRecords("test.log") == std::vector<std::string>{"first"});
+    CHECK(fileManager.truncateRecords("test.log"));
+
+    // Without the truncation these would sit behind the torn frame
+    CHECK(fileManager.appendRecord("test.log", "a"));
+    CHECK(fileManager.appendRecord("test.log", "b"));
+    CHECK(fileManager.appendRecord("test.log", "c"));
+    CHECK((fileManager.readRecords("test.log") == std::vector<std::string>{"first", "a", "b", "c"}));
+
+    // An intact log, or none at all, is left alone
+    CHECK(fileManager.truncateRecords("test.log"));
+    CHECK(fileManager.readRecords("test.log").size() == 4);
+    CHECK(fileManager.truncateRecords("missing.log"));
+}
+
+void testPayloadsAreByteExact() {
+    std::string dir = TestSupport::scratchDirectory("byte-exact");
+    FileManager fileManager(dir);
+
+    // Products may carry an untrimmed extra field from the form
+    std::vector<std::string> payloads = {"7|Latte|25000|coffee|double ", "\t leading", "x\r", "   "};
+    for (const auto& payload : payloads) {
+        CHECK(fileManager.appendRecord("test.log", payload));
+    }
+    CHECK(fileManager.readRecords("test.log") == payloads);
+}
+
+void testCorruptFrameStopsReplay() {
+    std::string dir = TestSupport::scratchDirectory("corrupt-frame");
+    FileManager fileManager(dir);
+
+    CHECK(fileManager.appendRecord("test.log", "kept"));
+    appendRaw(dir + "test.log", "@|4|00000000|bad!\n");
+    CHECK(fileManager.appendRecord("test.log", "after"));
+    CHECK(fileManager.readRecords("test.log") == std::vector<std::string>{"kept"});
+}
+
+void testTransactionLogRecoversAfterTornTail() {
+    std::string dir = TestSupport::scratchDirectory("transaction-log");
+    FileManager fileManager(dir);
+    fileManager.writeLines("products.txt", {"1|Espresso|18000|coffee|single"});
+
+    Transaction sale;
+    sale.setId(1);
+    sale.setCustomerId(0);
+    sale.setCurrentDateTime();
+    sale.addItem(TransactionItem(1, "Espresso", 18000, 2));
+    {
+        ProductController products(fileManager);
+        CustomerController customers(fileManager);
+        TransactionController transactions(fileManager, products, customers);
+        products.loadFromFile();
+        customers.loadFromFile();
+        transactions.loadFromFile();
+        CHECK(transactions.add(sale));
+    }
+    appendRaw(dir + "transactions.log", "@|40|1234");
+
+    for (int id = 2; id <= 3; ++id) {
+        ProductController products(fileManager);
+        CustomerController customers(fileManager);
+        TransactionController transactions(fileManager, products, customers);
+        products.loadFromFile();
+        customers.loadFromFile();
+        transactions.loadFromFile();
+
+        sale.setId(id);
+        CHECK(transactions.add(sale));
+    }
+
+    ProductController products(fileManager);
+    CustomerController customers(fileManager);
+    TransactionController transactions(fileManager, products, customers);
+    products.loadFromFile();
+    customers.loadFromFile();
+    transactions.loadFromFile();
+    CHECK(transactions.getCount() == 3);
+    CHECK(transactions.getById(3) != nullptr);
+}
+
+} // namespace
+
+int main() {
+    testTornTailIsTruncated();
+    testPayloadsAreByteExact();
+    testCorruptFrameStopsReplay();
+    testTransactionLogRecoversAfterTornTail();
+    return TestSupport::finish("RecordLogTest");
+}
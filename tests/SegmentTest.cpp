@@ -0,0 +1,100 @@
+/**
+ * @file SegmentTest.cpp
+ * @brief Monthly segments: totals, recent sales and customer history
+ *        across sealed months that are not loaded
+ */
+
+#include "TestSupport.h"
+#include "../utils/DateTime.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int CUSTOMER_ID = 7;
+
+Transaction makeSale(int id, std::int64_t timestamp, int quantity) {
+    return TestSupport::makeSale(id, timestamp, quantity, CUSTOMER_ID);
+}
+
+// One sale two months ago, one last month and one this month, with the
+// first two sealed into segment files
+std::vector<Transaction> prepare(FileManager& fileManager) {
+    fileManager.writeLines("products.txt", {"1|Espresso|18000|coffee|single"});
+
+    std::int64_t thisMonth = DateTime::startOfMonth(DateTime::now());
+    std::int64_t lastMonth = DateTime::startOfMonth(thisMonth - 1);
+    std::int64_t twoMonthsAgo = DateTime::startOfMonth(lastMonth - 1);
+    std::vector<Transaction> sales = {
+        makeSale(1, twoMonthsAgo + 3600, 1),
+        makeSale(2, lastMonth + 3600, 2),
+        makeSale(3, thisMonth, 3),
+    };
+
+    Store store(fileManager);
+    for (const auto& sale : sales) {
+        CHECK(store.transactions.add(sale));
+    }
+    CHECK(store.transactions.saveToFile());
+    return sales;
+}
+
+void testTotalsIncludeSealedMonths() {
+    std::string dir = TestSupport::scratchDirectory("segment-totals");
+    FileManager fileManager(dir);
+    std::vector<Transaction> sales = prepare(fileManager);
+
+    Store store(fileManager);
+    Money expected = 0;
+    for (const auto& sale : sales) {
+        expected += sale.getTotal();
+    }
+    CHECK(store.transactions.getCount() == 3);
+    CHECK(store.transactions.getTotalRevenue() == expected);
+    CHECK(store.transactions.getCountByCustomerId(CUSTOMER_ID) == 3);
+}
+
+void testRecentLoadsNewestMonthsFirst() {
+    std::string dir = TestSupport::scratchDirectory("segment-recent");
+    FileManager fileManager(dir);
+    prepare(fileManager);
+
+    Store store(fileManager);
+
+    // Loading the oldest month first must not let it hide last month
+    store.transactions.getById(1);
+    std::vector<Transaction*> recent = store.transactions.getRecent(2);
+    CHECK(recent.size() == 2 && recent[0]->getId() == 3 && recent[1]->getId() == 2);
+}
+
+void testCustomerHistoryStaysInTimeOrder() {
+    std::string dir = TestSupport::scratchDirectory("segment-postings");
+    FileManager fileManager(dir);
+    prepare(fileManager);
+
+    // Last month is loaded before the month ahead of it
+    Store store(fileManager);
+    store.transactions.getById(2);
+
+    std::vector<Transaction*> history = store.transactions.getByCustomerId(CUSTOMER_ID);
+    CHECK(history.size() == 3);
+    for (std::size_t i = 0; i < history.size(); ++i) {
+        CHECK(history[i]->getId() == static_cast<int>(i) + 1);
+    }
+
+    // Moving a sale back in time re-files it in its posting list
+    Transaction moved = *history[2];
+    moved.setTimestamp(history[0]->getTimestamp() - 60);
+    CHECK(store.transactions.update(moved));
+    history = store.transactions.getByCustomerId(CUSTOMER_ID);
+    CHECK(history.size() == 3 && history[0]->getId() == 3);
+}
+
+} // namespace
+
+int main() {
+    testTotalsIncludeSealedMonths();
+    testRecentLoadsNewestMonthsFirst();
+    testCustomerHistoryStaysInTimeOrder();
+    return TestSupport::finish("SegmentTest");
+}
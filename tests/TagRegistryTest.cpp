@@ -0,0 +1,71 @@
+/**
+ * @file TagRegistryTest.cpp
+ * @brief Tag interning: the same tag from every thread, and no wrapping
+ *        once all tags are taken
+ */
+
+#include "TestSupport.h"
+#include "../utils/TagRegistry.h"
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Tag = TagRegistry::Tag;
+
+void testInternFromManyThreads() {
+    constexpr int THREADS = 8;
+    constexpr int NAMES = 500;
+
+    std::vector<std::vector<Tag>> seen(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t, &seen] {
+            for (int i = 0; i < NAMES; ++i) {
+                seen[t].push_back(TagRegistry::getInstance().intern("shared-" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    TagRegistry& registry = TagRegistry::getInstance();
+    for (int t = 0; t < THREADS; ++t) {
+        CHECK(seen[t] == seen[0]);
+    }
+    for (int i = 0; i < NAMES; ++i) {
+        CHECK(registry.getName(seen[0][i]) == "shared-" + std::to_string(i));
+    }
+}
+
+void testFullRegistryDoesNotWrap() {
+    TagRegistry& registry = TagRegistry::getInstance();
+    Tag single = registry.intern("single");
+
+    // Take every remaining tag
+    Tag last = 0;
+    for (int i = 0; last < std::numeric_limits<Tag>::max(); ++i) {
+        last = registry.intern("filler-" + std::to_string(i));
+    }
+    CHECK(registry.getName(last).compare(0, 7, "filler-") == 0);
+
+    // Wrapping would hand these the tags of "" and the first value interned
+    std::string first = registry.getName(1);
+    CHECK(registry.intern("one-too-many") == 0);
+    CHECK(registry.intern("two-too-many") == 0);
+    CHECK(registry.getName(0).empty());
+    CHECK(registry.getName(1) == first);
+    CHECK(registry.intern("single") == single);
+    CHECK(registry.getName(single) == "single");
+}
+
+} // namespace
+
+int main() {
+    testInternFromManyThreads();
+    testFullRegistryDoesNotWrap();
+    return TestSupport::finish("TagRegistryTest");
+}
@@ -0,0 +1,140 @@
+/**
+ * @file TestSupport.h
+ * @brief Minimal check macro, scratch data directories and shared
+ *        fixtures for the tests
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only reports failed checks and prepares test data
+ * - DRY: Fixtures used by several tests live here once
+ */
+
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+#include "../utils/FileManager.h"
+#include "../utils/BackgroundWriter.h"
+#include "../controllers/CustomerController.h"
+#include "../controllers/ProductController.h"
+#include "../controllers/TransactionController.h"
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class TestSupport
+ * @brief Shared plumbing for the test executables
+ *
+ * Each test is a plain executable run by CTest. A failed CHECK is
+ * reported and counted, and the test keeps going so one run shows every
+ * failure; finish() turns the count into the exit code.
+ */
+class TestSupport {
+private:
+    // Static utility class - no instances
+    TestSupport() = delete;
+
+public:
+    /**
+     * @brief Gets the number of failed checks so far
+     */
+    static int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+    /**
+     * @brief Creates an empty data directory under the working directory
+     * @param name Directory name (one per test case)
+     * @return Path with a trailing '/', ready for FileManager
+     */
+    static std::string scratchDirectory(const std::string& name) {
+        std::filesystem::path path = std::filesystem::current_path() / "test-data" / name;
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+        return path.string() + "/";
+    }
+
+    /**
+     * @brief Reports the result of a test executable
+     * @param name Test name
+     * @return Exit code: 0 if every check passed
+     */
+    static int finish(const char* name) {
+        if (failures() == 0) {
+            std::cout << name << ": all checks passed\n";
+            return 0;
+        }
+        std::cerr << name << ": " << failures() << " check(s) failed\n";
+        return 1;
+    }
+
+    /**
+     * @brief Builds a sale of espressos (product 1 at 18000)
+     * @param id Transaction ID
+     * @param timestamp Sale time
+     * @param quantity Number of espressos
+     * @param customerId Customer ID (0 for a guest)
+     * @return Sale with its total calculated
+     */
+    static Transaction makeSale(int id, std::int64_t timestamp, int quantity, int customerId = 0) {
+        Transaction sale;
+        sale.setId(id);
+        sale.setCustomerId(customerId);
+        sale.setTimestamp(timestamp);
+        sale.addItem(TransactionItem(1, "Espresso", 18000, quantity));
+        sale.recalculate();
+        return sale;
+    }
+
+    /**
+     * @brief Writes the files a background save would have written
+     * @param fileManager File I/O handler
+     * @param files Files from a snapshot
+     * @return true if every file was written
+     */
+    static bool writeAll(const FileManager& fileManager, const std::vector<PendingFile>& files) {
+        for (const auto& file : files) {
+            if (!fileManager.writeBuffer(file.filename, file.data)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @struct Store
+ * @brief The three controllers, loaded the way the application starts up
+ */
+struct Store {
+    ProductController products;
+    CustomerController customers;
+    TransactionController transactions;
+
+    explicit Store(FileManager& fileManager)
+        : products(fileManager)
+        , customers(fileManager)
+        , transactions(fileManager, products, customers)
+    {
+        products.loadFromFile();
+        customers.loadFromFile();
+        transactions.loadFromFile();
+    }
+
+    bool save() {
+        return products.saveToFile() && customers.saveToFile() && transactions.saveToFile();
+    }
+};
+
+#define CHECK(condition)                                                      \
+    do {                                                                      \
+        if (!(condition)) {                                                   \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: "    \
+                      << #condition << "\n";                                  \
+            ++TestSupport::failures();                                        \
+        }                                                                     \
+    } while (0)
+
+#endif // TESTSUPPORT_H
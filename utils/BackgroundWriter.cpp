@@ -0,0 +1,76 @@
+/**
+ * @file BackgroundWriter.cpp
+ * @brief Implementation of BackgroundWriter
+ */
+
+#include "BackgroundWriter.h"
+
+BackgroundWriter::BackgroundWriter(const FileManager& fileManager)
+    : m_fileManager(fileManager)
+    , m_writing(false)
+    , m_stopping(false)
+{
+    m_worker = std::thread(&BackgroundWriter::run, this);
+}
+
+BackgroundWriter::~BackgroundWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_worker.join();
+}
+
+void BackgroundWriter::submit(SaveBatch batch) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(batch));
+    }
+    m_wake.notify_one();
+}
+
+void BackgroundWriter::waitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_queue.empty() && !m_writing; });
+}
+
+bool BackgroundWriter::isBusy() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_queue.empty() || m_writing;
+}
+
+void BackgroundWriter::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+        if (m_queue.empty()) {
+            return;  // Stopping and fully drained
+        }
+
+        SaveBatch batch = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_writing = true;
+        lock.unlock();
+
+        bool success = true;
+        for (const auto& file : batch.files) {
+            success = file.append
+                ? m_fileManager.appendBuffer(file.filename, file.data)
+                : m_fileManager.writeBuffer(file.filename, file.data);
+            if (!success) {
+                break;
+            }
+        }
+        if (batch.onComplete) {
+            batch.onComplete(success);
+        }
+
+        lock.lock();
+        m_writing = false;
+        if (m_queue.empty()) {
+            m_idle.notify_all();
+        }
+    }
+}
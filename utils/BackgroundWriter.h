@@ -0,0 +1,104 @@
+/**
+ * @file BackgroundWriter.h
+ * @brief Worker thread that writes serialized data files off the GUI thread
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only moves prepared buffers to disk
+ * - Dependency Inversion: Writes through FileManager, knows nothing of controllers
+ */
+
+#ifndef BACKGROUNDWRITER_H
+#define BACKGROUNDWRITER_H
+
+#include "FileManager.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct PendingFile
+ * @brief New content for one file
+ */
+struct PendingFile {
+    std::string filename;  ///< Name of the file (relative to data path)
+    std::string data;      ///< Complete file content, or bytes to append
+    bool append = false;   ///< Append data instead of replacing the file
+};
+
+/**
+ * @struct SaveBatch
+ * @brief Files written together, with a callback once they are done
+ */
+struct SaveBatch {
+    std::vector<PendingFile> files;           ///< Files to write, in order (stops at the first failure)
+    std::function<void(bool)> onComplete;     ///< Called on the writer thread with the result
+};
+
+/**
+ * @class BackgroundWriter
+ * @brief Writes save batches on a dedicated thread, in submission order
+ *
+ * Callers serialize their state into buffers (cheap, in memory) and hand
+ * them over with submit(); the slow file writes then happen without
+ * blocking the caller. Batches are written strictly in the order they
+ * were submitted, so a later save never gets overwritten by an earlier one.
+ * Within a batch, writing stops at the first file that fails: later files
+ * may depend on earlier ones (a journal reset on its compacted table, a
+ * manifest on its segments), and the failure callback makes the next save
+ * write everything again.
+ */
+class BackgroundWriter {
+private:
+    const FileManager& m_fileManager;      ///< File I/O used by the worker
+    std::deque<SaveBatch> m_queue;         ///< Batches waiting to be written
+    bool m_writing;                        ///< Worker is writing a batch
+    bool m_stopping;                       ///< Destructor asked the worker to exit
+    mutable std::mutex m_mutex;            ///< Guards the queue and flags
+    std::condition_variable m_wake;        ///< Signals new work or shutdown
+    std::condition_variable m_idle;        ///< Signals the queue has drained
+    std::thread m_worker;                  ///< Worker thread
+
+    /**
+     * @brief Worker loop: writes batches until stopped and drained
+     */
+    void run();
+
+public:
+    /**
+     * @brief Starts the worker thread
+     * @param fileManager File I/O used for writing (must outlive the writer)
+     */
+    explicit BackgroundWriter(const FileManager& fileManager);
+
+    /**
+     * @brief Writes any queued batches, then stops the worker thread
+     */
+    ~BackgroundWriter();
+
+    // Non-copyable: owns a thread
+    BackgroundWriter(const BackgroundWriter&) = delete;
+    BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+
+    /**
+     * @brief Queues a batch for writing and returns immediately
+     * @param batch Files to write and completion callback
+     */
+    void submit(SaveBatch batch);
+
+    /**
+     * @brief Blocks until every submitted batch has been written
+     */
+    void waitIdle();
+
+    /**
+     * @brief Checks whether batches are queued or being written
+     * @return true if a save is still in progress
+     */
+    bool isBusy() const;
+};
+
+#endif // BACKGROUNDWRITER_H
@@ -0,0 +1,182 @@
+/**
+ * @file BinaryIO.h
+ * @brief Fixed-width and varint binary encoding for the state image and archives
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only turns numbers and strings into bytes and back
+ * - DRY: Shared by every model and controller that writes to the image
+ */
+
+#ifndef BINARYIO_H
+#define BINARYIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @class BinaryWriter
+ * @brief Appends values to a byte buffer in host byte order
+ *
+ * The image is a cache of the text files on the same machine, so host
+ * byte order is fine; StateImage rejects images written elsewhere.
+ */
+class BinaryWriter {
+private:
+    std::string& m_buffer;  ///< Buffer being appended to
+
+public:
+    /**
+     * @brief Constructs a writer appending to a buffer
+     * @param buffer Buffer to append to (must outlive the writer)
+     */
+    explicit BinaryWriter(std::string& buffer) : m_buffer(buffer) {}
+
+    /**
+     * @brief Appends an integer in its fixed width
+     * @param value Value to append
+     */
+    template<typename T>
+    void put(T value) {
+        static_assert(std::is_integral_v<T>, "BinaryWriter::put takes integers");
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        m_buffer.append(bytes, sizeof(T));
+    }
+
+    /**
+     * @brief Appends a length-prefixed string
+     * @param text Text to append
+     */
+    void putString(std::string_view text) {
+        put(static_cast<std::uint32_t>(text.size()));
+        m_buffer.append(text);
+    }
+
+    /**
+     * @brief Appends an unsigned integer in 1-10 bytes (LEB128, 7 bits per byte)
+     * @param value Value to append
+     */
+    void putVarint(std::uint64_t value) {
+        while (value >= 0x80) {
+            m_buffer += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        m_buffer += static_cast<char>(value);
+    }
+
+    /**
+     * @brief Appends a signed integer as a zigzag varint
+     * @param value Value to append (small magnitudes of either sign stay short)
+     */
+    void putSignedVarint(std::int64_t value) {
+        putVarint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+    }
+};
+
+/**
+ * @class BinaryReader
+ * @brief Reads values written by BinaryWriter, with bounds checking
+ *
+ * Reading past the end does not throw; it sets the reader to failed and
+ * returns zeros, so callers check ok() once after a group of reads.
+ */
+class BinaryReader {
+private:
+    const char* m_cursor;  ///< Next byte to read
+    const char* m_end;     ///< One past the last byte
+    bool m_ok;             ///< False once a read ran past the end
+
+    /**
+     * @brief Claims the next bytes, or fails the reader if too few remain
+     * @param size Number of bytes
+     * @return Start of the bytes, nullptr on failure
+     */
+    const char* take(std::size_t size) {
+        if (!m_ok || static_cast<std::size_t>(m_end - m_cursor) < size) {
+            m_ok = false;
+            return nullptr;
+        }
+        const char* start = m_cursor;
+        m_cursor += size;
+        return start;
+    }
+
+public:
+    /**
+     * @brief Constructs a reader over a byte range
+     * @param data Bytes to read (must outlive the reader)
+     */
+    explicit BinaryReader(std::string_view data)
+        : m_cursor(data.data()), m_end(data.data() + data.size()), m_ok(true) {}
+
+    /**
+     * @brief Reads an integer of the given type
+     * @return The value, or 0 if the data ran out
+     */
+    template<typename T>
+    T get() {
+        static_assert(std::is_integral_v<T>, "BinaryReader::get reads integers");
+        T value = 0;
+        if (const char* bytes = take(sizeof(T))) {
+            std::memcpy(&value, bytes, sizeof(T));
+        }
+        return value;
+    }
+
+    /**
+     * @brief Reads a length-prefixed string without copying
+     * @return View into the source bytes (empty if the data ran out)
+     */
+    std::string_view getString() {
+        std::uint32_t size = get<std::uint32_t>();
+        const char* bytes = take(size);
+        return bytes ? std::string_view(bytes, size) : std::string_view();
+    }
+
+    /**
+     * @brief Reads an integer written by BinaryWriter::putVarint()
+     * @return The value, or 0 if the data ran out or the varint is too long
+     */
+    std::uint64_t getVarint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const char* byte = take(1);
+            if (!byte) {
+                return 0;
+            }
+            value |= static_cast<std::uint64_t>(static_cast<unsigned char>(*byte) & 0x7F) << shift;
+            if ((static_cast<unsigned char>(*byte) & 0x80) == 0) {
+                return value;
+            }
+        }
+        m_ok = false;
+        return 0;
+    }
+
+    /**
+     * @brief Reads an integer written by BinaryWriter::putSignedVarint()
+     * @return The value, or 0 on failure
+     */
+    std::int64_t getSignedVarint() {
+        std::uint64_t value = getVarint();
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    /**
+     * @brief Checks whether every read so far succeeded
+     * @return true if no read ran past the end
+     */
+    bool ok() const { return m_ok; }
+
+    /**
+     * @brief Checks whether all bytes have been consumed
+     * @return true at the end of the data
+     */
+    bool atEnd() const { return m_cursor == m_end; }
+};
+
+#endif // BINARYIO_H
@@ -0,0 +1,59 @@
+/**
+ * @file ChangeTracker.cpp
+ * @brief Implementation of ChangeTracker class
+ */
+
+#include "ChangeTracker.h"
+#include <algorithm>
+
+ChangeTracker::ChangeTracker()
+    : m_fullSaveRequired(false)
+{
+}
+
+void ChangeTracker::markChanged(int id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_removed.erase(id);
+    m_changed.insert(id);
+}
+
+void ChangeTracker::markRemoved(int id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_changed.erase(id);
+    m_removed.insert(id);
+}
+
+void ChangeTracker::requireFullSave() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fullSaveRequired = true;
+}
+
+bool ChangeTracker::hasChanges() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fullSaveRequired || !m_changed.empty() || !m_removed.empty();
+}
+
+ChangeSet ChangeTracker::take() {
+    ChangeSet changes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        changes.changed.assign(m_changed.begin(), m_changed.end());
+        changes.removed.assign(m_removed.begin(), m_removed.end());
+        changes.fullSaveRequired = m_fullSaveRequired;
+        m_changed.clear();
+        m_removed.clear();
+        m_fullSaveRequired = false;
+    }
+
+    // Sorted so journals are written in a stable, readable order
+    std::sort(changes.changed.begin(), changes.changed.end());
+    std::sort(changes.removed.begin(), changes.removed.end());
+    return changes;
+}
+
+void ChangeTracker::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_changed.clear();
+    m_removed.clear();
+    m_fullSaveRequired = false;
+}
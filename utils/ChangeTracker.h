@@ -0,0 +1,86 @@
+/**
+ * @file ChangeTracker.h
+ * @brief Records which entities changed since the last save
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only remembers changed and removed IDs
+ * - DRY: Shared by every controller that saves incrementally
+ */
+
+#ifndef CHANGETRACKER_H
+#define CHANGETRACKER_H
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @struct ChangeSet
+ * @brief Changes taken from a ChangeTracker for one save
+ */
+struct ChangeSet {
+    std::vector<int> changed;       ///< IDs added or modified
+    std::vector<int> removed;       ///< IDs removed
+    bool fullSaveRequired = false;  ///< Deltas alone cannot be trusted; rewrite everything
+};
+
+/**
+ * @class ChangeTracker
+ * @brief Set of IDs added, modified or removed since the last save
+ *
+ * An ID is either changed or removed, never both: the latest mark wins.
+ * All methods are thread-safe, so balances changed from checkout threads
+ * can be marked without further locking.
+ */
+class ChangeTracker {
+private:
+    std::unordered_set<int> m_changed;  ///< IDs added or modified
+    std::unordered_set<int> m_removed;  ///< IDs removed
+    bool m_fullSaveRequired;            ///< Set after a failed save
+    mutable std::mutex m_mutex;         ///< Guards all members
+
+public:
+    /**
+     * @brief Constructs an empty tracker
+     */
+    ChangeTracker();
+
+    /**
+     * @brief Records that an entity was added or modified
+     * @param id Entity ID
+     */
+    void markChanged(int id);
+
+    /**
+     * @brief Records that an entity was removed
+     * @param id Entity ID
+     */
+    void markRemoved(int id);
+
+    /**
+     * @brief Asks the next save to rewrite the whole file
+     *
+     * Used when a save failed, since its changes were already taken.
+     */
+    void requireFullSave();
+
+    /**
+     * @brief Checks whether anything needs saving
+     * @return true if there are changes or a full save is required
+     */
+    bool hasChanges() const;
+
+    /**
+     * @brief Takes all recorded changes, leaving the tracker empty
+     * @return Changed and removed IDs (each sorted) and the full-save flag
+     */
+    ChangeSet take();
+
+    /**
+     * @brief Forgets all changes (after loading or a full save)
+     */
+    void clear();
+};
+
+#endif // CHANGETRACKER_H
@@ -0,0 +1,175 @@
+/**
+ * @file DateTime.cpp
+ * @brief Implementation of DateTime class
+ */
+
+#include "DateTime.h"
+#include <ctime>
+
+namespace {
+
+// Parses exactly `width` digits starting at text[pos]
+bool parseDigits(std::string_view text, std::size_t pos, std::size_t width, int& value) {
+    if (pos + width > text.size()) {
+        return false;
+    }
+
+    value = 0;
+    for (std::size_t i = pos; i < pos + width; ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            return false;
+        }
+        value = value * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+// Length of a month (1-12) in the proleptic Gregorian calendar
+int daysInMonth(int year, int month) {
+    static const int DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return (month == 2 && leap) ? 29 : DAYS[month - 1];
+}
+
+void appendDigits(std::string& buffer, int value, int width) {
+    char digits[8];
+    for (int i = width - 1; i >= 0; --i) {
+        digits[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    buffer.append(digits, static_cast<std::size_t>(width));
+}
+
+} // namespace
+
+std::int64_t DateTime::now() {
+    std::time_t time = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &time);
+#else
+    localtime_r(&time, &local);
+#endif
+
+    return daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday) * SECONDS_PER_DAY
+         + local.tm_hour * SECONDS_PER_HOUR + local.tm_min * 60 + local.tm_sec;
+}
+
+bool DateTime::parse(std::string_view text, std::int64_t& timestamp) {
+    int year, month, day;
+    if (!parseDigits(text, 0, 4, year) || text.size() < 10 || text[4] != '-' ||
+        !parseDigits(text, 5, 2, month) || text[7] != '-' ||
+        !parseDigits(text, 8, 2, day) ||
+        month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
+    }
+
+    int hour = 0, minute = 0, second = 0;
+    if (text.size() > 10) {
+        if (text.size() != 19 || text[10] != ' ' ||
+            !parseDigits(text, 11, 2, hour) || text[13] != ':' ||
+            !parseDigits(text, 14, 2, minute) || text[16] != ':' ||
+            !parseDigits(text, 17, 2, second) ||
+            hour > 23 || minute > 59 || second > 59) {
+            return false;
+        }
+    }
+
+    timestamp = daysFromCivil(year, month, day) * SECONDS_PER_DAY
+              + hour * SECONDS_PER_HOUR + minute * 60 + second;
+    return true;
+}
+
+std::string DateTime::format(std::int64_t timestamp) {
+    std::string text;
+    text.reserve(19);
+    formatTo(text, timestamp);
+    return text;
+}
+
+void DateTime::formatTo(std::string& buffer, std::int64_t timestamp) {
+    std::int64_t days = startOfDay(timestamp) / SECONDS_PER_DAY;
+    int secondsOfDay = static_cast<int>(timestamp - days * SECONDS_PER_DAY);
+
+    int year, month, day;
+    civilFromDays(days, year, month, day);
+
+    appendDigits(buffer, year, 4);
+    buffer += '-';
+    appendDigits(buffer, month, 2);
+    buffer += '-';
+    appendDigits(buffer, day, 2);
+    buffer += ' ';
+    appendDigits(buffer, secondsOfDay / 3600, 2);
+    buffer += ':';
+    appendDigits(buffer, (secondsOfDay / 60) % 60, 2);
+    buffer += ':';
+    appendDigits(buffer, secondsOfDay % 60, 2);
+}
+
+std::int64_t DateTime::daysFromCivil(int year, int month, int day) {
+    // Howard Hinnant's days_from_civil
+    year -= month <= 2 ? 1 : 0;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int yearOfEra = static_cast<int>(year - era * 400);
+    const int dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+void DateTime::civilFromDays(std::int64_t days, int& year, int& month, int& day) {
+    // Howard Hinnant's civil_from_days
+    days += 719468;
+    const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const int dayOfEra = static_cast<int>(days - era * 146097);
+    const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int monthIndex = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    year = static_cast<int>(yearOfEra + era * 400) + (month <= 2 ? 1 : 0);
+}
+
+std::int64_t DateTime::startOfMonth(std::int64_t timestamp) {
+    int year, month, day;
+    civilFromDays(startOfDay(timestamp) / SECONDS_PER_DAY, year, month, day);
+    return daysFromCivil(year, month, 1) * SECONDS_PER_DAY;
+}
+
+std::int64_t DateTime::startOfNextMonth(std::int64_t timestamp) {
+    int year, month, day;
+    civilFromDays(startOfDay(timestamp) / SECONDS_PER_DAY, year, month, day);
+    return (month == 12 ? daysFromCivil(year + 1, 1, 1) : daysFromCivil(year, month + 1, 1))
+         * SECONDS_PER_DAY;
+}
+
+std::string DateTime::formatMonth(std::int64_t timestamp) {
+    int year, month, day;
+    civilFromDays(startOfDay(timestamp) / SECONDS_PER_DAY, year, month, day);
+
+    std::string text;
+    text.reserve(7);
+    appendDigits(text, year, 4);
+    text += '-';
+    appendDigits(text, month, 2);
+    return text;
+}
+
+bool DateTime::parseMonth(std::string_view text, std::int64_t& timestamp) {
+    int year, month;
+    if (text.size() != 7 || !parseDigits(text, 0, 4, year) || text[4] != '-' ||
+        !parseDigits(text, 5, 2, month) || month < 1 || month > 12) {
+        return false;
+    }
+
+    timestamp = daysFromCivil(year, month, 1) * SECONDS_PER_DAY;
+    return true;
+}
+
+std::int64_t DateTime::startOfDay(std::int64_t timestamp) {
+    std::int64_t days = timestamp / SECONDS_PER_DAY;
+    if (timestamp % SECONDS_PER_DAY < 0) {
+        --days;
+    }
+    return days * SECONDS_PER_DAY;
+}
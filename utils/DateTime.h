@@ -0,0 +1,114 @@
+/**
+ * @file DateTime.h
+ * @brief Integer timestamp helpers for transaction dates
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only converts between timestamps and text
+ */
+
+#ifndef DATETIME_H
+#define DATETIME_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @class DateTime
+ * @brief Converts "YYYY-MM-DD HH:MM:SS" text to and from integer timestamps
+ *
+ * Timestamps count seconds since 1970-01-01 00:00:00 in shop-local
+ * wall-clock time (no time zone offset is applied). Comparing, sorting and
+ * bucketing by day are plain integer operations, and the text form is only
+ * produced at display and file boundaries.
+ */
+class DateTime {
+public:
+    static constexpr std::int64_t SECONDS_PER_DAY = 86400;
+    static constexpr std::int64_t SECONDS_PER_HOUR = 3600;
+
+    /**
+     * @brief Gets the current local wall-clock time
+     * @return Timestamp for now
+     */
+    static std::int64_t now();
+
+    /**
+     * @brief Parses "YYYY-MM-DD" or "YYYY-MM-DD HH:MM:SS"
+     * @param text Text to parse
+     * @param timestamp Receives the result on success
+     * @return true if the text was a valid date/time (day checked against
+     *         the month's length, leap years included)
+     */
+    static bool parse(std::string_view text, std::int64_t& timestamp);
+
+    /**
+     * @brief Formats a timestamp as "YYYY-MM-DD HH:MM:SS"
+     * @param timestamp Timestamp to format
+     * @return Formatted text
+     */
+    static std::string format(std::int64_t timestamp);
+
+    /**
+     * @brief Appends "YYYY-MM-DD HH:MM:SS" to a buffer
+     * @param buffer Buffer to append to
+     * @param timestamp Timestamp to format
+     */
+    static void formatTo(std::string& buffer, std::int64_t timestamp);
+
+    /**
+     * @brief Gets the number of days since 1970-01-01 for a calendar date
+     * @param year Year
+     * @param month Month (1-12)
+     * @param day Day of month (1-31)
+     * @return Day number
+     */
+    static std::int64_t daysFromCivil(int year, int month, int day);
+
+    /**
+     * @brief Gets the calendar date of a day number
+     * @param days Days since 1970-01-01
+     * @param year Receives the year
+     * @param month Receives the month (1-12)
+     * @param day Receives the day of month (1-31)
+     */
+    static void civilFromDays(std::int64_t days, int& year, int& month, int& day);
+
+    /**
+     * @brief Gets the timestamp of midnight at the start of a timestamp's day
+     * @param timestamp Any time within the day
+     * @return Start-of-day timestamp
+     */
+    static std::int64_t startOfDay(std::int64_t timestamp);
+
+    /**
+     * @brief Gets the timestamp of midnight on the first of a timestamp's month
+     * @param timestamp Any time within the month
+     * @return Start-of-month timestamp
+     */
+    static std::int64_t startOfMonth(std::int64_t timestamp);
+
+    /**
+     * @brief Gets the start of the month after a timestamp's month
+     * @param timestamp Any time within the month
+     * @return Start-of-month timestamp of the following month
+     */
+    static std::int64_t startOfNextMonth(std::int64_t timestamp);
+
+    /**
+     * @brief Formats a timestamp's month as "YYYY-MM"
+     * @param timestamp Any time within the month
+     * @return Formatted month
+     */
+    static std::string formatMonth(std::int64_t timestamp);
+
+    /**
+     * @brief Parses "YYYY-MM" as written by formatMonth()
+     * @param text Text to parse
+     * @param timestamp Receives the start of the month on success
+     * @return true if the text was a valid month
+     */
+    static bool parseMonth(std::string_view text, std::int64_t& timestamp);
+};
+
+#endif // DATETIME_H
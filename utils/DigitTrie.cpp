@@ -0,0 +1,98 @@
+/**
+ * @file DigitTrie.cpp
+ * @brief Implementation of DigitTrie class
+ */
+
+#include "DigitTrie.h"
+#include <algorithm>
+
+DigitTrie::DigitTrie() {
+    clear();
+}
+
+std::int32_t DigitTrie::find(std::string_view key) const {
+    std::int32_t node = 0;
+    for (char c : key) {
+        if (c < '0' || c > '9') {
+            return -1;
+        }
+        node = m_nodes[static_cast<std::size_t>(node)].children[static_cast<std::size_t>(c - '0')];
+        if (node < 0) {
+            return -1;
+        }
+    }
+    return node;
+}
+
+void DigitTrie::insert(std::string_view key, int value) {
+    if (!std::all_of(key.begin(), key.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return;
+    }
+
+    std::size_t node = 0;
+    for (char c : key) {
+        std::size_t digit = static_cast<std::size_t>(c - '0');
+        if (m_nodes[node].children[digit] < 0) {
+            m_nodes[node].children[digit] = static_cast<std::int32_t>(m_nodes.size());
+            Node child;
+            child.children.fill(-1);
+            m_nodes.push_back(std::move(child));
+        }
+        node = static_cast<std::size_t>(m_nodes[node].children[digit]);
+    }
+
+    m_nodes[node].values.push_back(value);
+}
+
+bool DigitTrie::erase(std::string_view key, int value) {
+    std::int32_t node = find(key);
+    if (node < 0) {
+        return false;
+    }
+
+    std::vector<int>& values = m_nodes[static_cast<std::size_t>(node)].values;
+    auto it = std::find(values.begin(), values.end(), value);
+    if (it == values.end()) {
+        return false;
+    }
+
+    values.erase(it);
+    return true;
+}
+
+std::vector<int> DigitTrie::findByPrefix(std::string_view prefix, std::size_t limit) const {
+    std::vector<int> result;
+    std::int32_t start = find(prefix);
+    if (start < 0 || limit == 0) {
+        return result;
+    }
+
+    // Depth-first in digit order so results come out sorted by key
+    std::vector<std::int32_t> stack{start};
+    while (!stack.empty() && result.size() < limit) {
+        const Node& node = m_nodes[static_cast<std::size_t>(stack.back())];
+        stack.pop_back();
+
+        for (int value : node.values) {
+            if (result.size() == limit) {
+                break;
+            }
+            result.push_back(value);
+        }
+
+        for (int digit = 9; digit >= 0; --digit) {
+            if (node.children[static_cast<std::size_t>(digit)] >= 0) {
+                stack.push_back(node.children[static_cast<std::size_t>(digit)]);
+            }
+        }
+    }
+
+    return result;
+}
+
+void DigitTrie::clear() {
+    m_nodes.clear();
+    Node root;
+    root.children.fill(-1);
+    m_nodes.push_back(std::move(root));
+}
@@ -0,0 +1,77 @@
+/**
+ * @file DigitTrie.h
+ * @brief Prefix tree over digit strings (e.g. phone numbers)
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only maps digit keys to values by prefix
+ */
+
+#ifndef DIGITTRIE_H
+#define DIGITTRIE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class DigitTrie
+ * @brief Maps digit-only keys to integer values with prefix lookup
+ *
+ * Each node has ten child slots, so walking a key costs one array index
+ * per digit regardless of how many keys are stored. Several values may
+ * share a key. Nodes emptied by erase() are kept for reuse until clear().
+ */
+class DigitTrie {
+private:
+    struct Node {
+        std::array<std::int32_t, 10> children;  ///< Child node per digit (-1 if none)
+        std::vector<int> values;                ///< Values whose key ends here
+    };
+
+    std::vector<Node> m_nodes;  ///< Node pool, m_nodes[0] is the root
+
+    /**
+     * @brief Finds the node for a key
+     * @param key Digit string
+     * @return Node index, -1 if absent or key has a non-digit
+     */
+    std::int32_t find(std::string_view key) const;
+
+public:
+    /**
+     * @brief Constructs an empty trie
+     */
+    DigitTrie();
+
+    /**
+     * @brief Adds a value under a key
+     * @param key Digit string (non-digit characters make the call a no-op)
+     * @param value Value to store
+     */
+    void insert(std::string_view key, int value);
+
+    /**
+     * @brief Removes a value from a key
+     * @param key Digit string
+     * @param value Value to remove
+     * @return true if the value was found and removed
+     */
+    bool erase(std::string_view key, int value);
+
+    /**
+     * @brief Collects values whose key starts with a prefix
+     * @param prefix Digit prefix (empty matches everything)
+     * @param limit Maximum number of values to return
+     * @return Values ordered by key
+     */
+    std::vector<int> findByPrefix(std::string_view prefix, std::size_t limit) const;
+
+    /**
+     * @brief Removes all keys
+     */
+    void clear();
+};
+
+#endif // DIGITTRIE_H
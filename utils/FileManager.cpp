@@ -7,10 +7,148 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace fs = std::filesystem;
 
+namespace {
+
+constexpr const char* TEMP_SUFFIX = ".tmp";
+
+#ifdef SKENA_FAULT_INJECTION
+// Test builds only: simulates a crash right after the named step of a
+// durable write when the SKENA_FAULT_STEP environment variable names it
+void faultPoint(const char* step) {
+    const char* target = std::getenv("SKENA_FAULT_STEP");
+    if (target != nullptr && std::strcmp(target, step) == 0) {
+        std::abort();
+    }
+}
+#else
+inline void faultPoint(const char*) {}
+#endif
+
+#ifndef _WIN32
+// Writes all of data, retrying short writes and interrupted calls
+bool writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+// Makes a rename inside the directory durable
+bool syncDirectory(const std::string& path) {
+    int fd = ::open(path.empty() ? "." : path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+}
+
+// Appends data and waits until it is on disk; a new file's directory
+// entry is synced too, or the file itself could vanish in a power cut
+bool appendDurably(const std::string& fullPath, const std::string& dataPath, std::string_view data) {
+    bool existed = ::access(fullPath.c_str(), F_OK) == 0;
+    int fd = ::open(fullPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    // A failed append is cut back off, or every later record would sit
+    // behind a torn frame that replay stops at
+    struct stat before {};
+    if (::fstat(fd, &before) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    bool written = writeAll(fd, data.data(), data.size()) && ::fsync(fd) == 0;
+    if (!written && ::ftruncate(fd, before.st_size) == 0) {
+        ::fsync(fd);
+    }
+    written = (::close(fd) == 0) && written;
+    return written && (existed || syncDirectory(dataPath));
+}
+#endif
+
+// Reads the frame "@|length|checksum|payload\n" starting at offset. The
+// payload is sliced by its length, not by line, so it may hold any bytes.
+// On success offset moves past the frame's newline.
+bool parseFrame(std::string_view data, std::size_t& offset, std::string_view& payload) {
+    std::string_view rest = data.substr(offset);
+    if (rest.size() < 2 || rest[0] != '@' || rest[1] != '|') {
+        return false;
+    }
+
+    const auto lengthEnd = rest.find('|', 2);
+    const auto checksumEnd = (lengthEnd == std::string_view::npos)
+        ? std::string_view::npos : rest.find('|', lengthEnd + 1);
+    if (checksumEnd == std::string_view::npos) {
+        return false;
+    }
+
+    std::size_t length = 0;
+    std::uint32_t sum = 0;
+    auto lengthResult = std::from_chars(rest.data() + 2, rest.data() + lengthEnd, length);
+    auto checksumResult = std::from_chars(rest.data() + lengthEnd + 1, rest.data() + checksumEnd, sum, 16);
+    if (lengthResult.ec != std::errc() || lengthResult.ptr != rest.data() + lengthEnd ||
+        checksumResult.ec != std::errc() || checksumResult.ptr != rest.data() + checksumEnd) {
+        return false;
+    }
+
+    // The newline is written last, so a frame without it is torn
+    std::size_t payloadStart = checksumEnd + 1;
+    if (length >= rest.size() - payloadStart || rest[payloadStart + length] != '\n') {
+        return false;
+    }
+
+    payload = rest.substr(payloadStart, length);
+    if (FileManager::checksum(payload) != sum) {
+        return false;
+    }
+
+    offset += payloadStart + length + 1;
+    return true;
+}
+
+// Walks the intact frames of a log, calling visit(payload) for each
+// Returns the offset just past the last intact frame
+template<typename Visitor>
+std::size_t scanFrames(std::string_view data, Visitor visit) {
+    std::size_t offset = 0;
+    std::string_view payload;
+    while (offset < data.size() && parseFrame(data, offset, payload)) {
+        visit(payload);
+    }
+    return offset;
+}
+
+} // namespace
+
 FileManager::FileManager(const std::string& dataPath)
     : m_dataPath(dataPath)
 {
@@ -34,40 +172,93 @@ void FileManager::setDataPath(const std::string& path) {
 
 std::vector<std::string> FileManager::readLines(const std::string& filename) const {
     std::vector<std::string> lines;
-    std::string fullPath = m_dataPath + filename;
 
-    std::ifstream file(fullPath);
-    if (!file.is_open()) {
-        return lines;  // Return empty vector if file doesn't exist
+    // Return empty vector if file doesn't exist
+    for (std::string_view line : mapFile(filename)) {
+        lines.emplace_back(line);
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        // Skip empty lines and comments (lines starting with #)
-        std::string trimmed = trim(line);
-        if (!trimmed.empty() && trimmed[0] != '#') {
-            lines.push_back(trimmed);
-        }
-    }
-
-    file.close();
     return lines;
 }
 
+MappedFile FileManager::mapFile(const std::string& filename) const {
+    return MappedFile(m_dataPath + filename);
+}
+
 bool FileManager::writeLines(const std::string& filename, const std::vector<std::string>& lines) const {
+    std::string buffer;
+    for (const auto& line : lines) {
+        buffer += line;
+        buffer += '\n';
+    }
+
+    return writeBuffer(filename, buffer);
+}
+
+bool FileManager::writeBuffer(const std::string& filename, std::string_view data) const {
+    // Write a temp file and rename it over the target: a crash at any point
+    // leaves either the complete old file or the complete new one
     std::string fullPath = m_dataPath + filename;
+    std::string tempPath = fullPath + TEMP_SUFFIX;
 
-    std::ofstream file(fullPath, std::ios::trunc);
-    if (!file.is_open()) {
+#ifdef _WIN32
+    {
+        std::ofstream file(tempPath, std::ios::trunc | std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        file.close();
+        if (file.fail()) {
+            return false;
+        }
+    }
+
+    // No fsync through iostreams; rename still replaces the target in one step
+    std::error_code error;
+    fs::rename(tempPath, fullPath, error);
+    return !error;
+#else
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
         return false;
     }
+    faultPoint("tmp-open");
 
-    for (const auto& line : lines) {
-        file << line << "\n";
+    // The data must be on disk before the rename can expose it
+    bool written = writeAll(fd, data.data(), data.size());
+    faultPoint("tmp-write");
+    written = written && ::fsync(fd) == 0;
+    faultPoint("fsync");
+    written = (::close(fd) == 0) && written;
+    if (!written || ::rename(tempPath.c_str(), fullPath.c_str()) != 0) {
+        ::unlink(tempPath.c_str());
+        return false;
     }
+    faultPoint("rename");
+
+    bool synced = syncDirectory(m_dataPath);
+    faultPoint("dir-fsync");
+    return synced;
+#endif
+}
 
+bool FileManager::appendBuffer(const std::string& filename, std::string_view data) const {
+    std::string fullPath = m_dataPath + filename;
+
+#ifdef _WIN32
+    std::ofstream file(fullPath, std::ios::app | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
     file.close();
-    return true;
+    return !file.fail();
+#else
+    return appendDurably(fullPath, m_dataPath, data);
+#endif
 }
 
 bool FileManager::appendLine(const std::string& filename, const std::string& line) const {
@@ -98,6 +289,130 @@ bool FileManager::ensureFileExists(const std::string& filename) const {
     return file.is_open();
 }
 
+bool FileManager::renameFile(const std::string& from, const std::string& to) const {
+    std::error_code error;
+    fs::rename(m_dataPath + from, m_dataPath + to, error);
+    return !error;
+}
+
+bool FileManager::removeFile(const std::string& filename) const {
+    std::error_code error;
+    fs::remove(m_dataPath + filename, error);
+    return !error;
+}
+
+bool FileManager::appendRecord(const std::string& filename, std::string_view payload) const {
+    std::string frame;
+    frameRecord(frame, payload);
+    return appendBuffer(filename, frame);
+}
+
+void FileManager::frameRecord(std::string& buffer, std::string_view payload) {
+    char header[32];
+    int headerLength = std::snprintf(header, sizeof(header), "@|%zu|%08x|", payload.size(),
+                                     static_cast<unsigned>(checksum(payload)));
+    buffer.append(header, static_cast<std::size_t>(headerLength));
+    buffer.append(payload);
+    buffer += '\n';
+}
+
+void FileManager::frameDeletion(std::string& buffer, int id) {
+    std::string payload;
+    formatDeletion(payload, id);
+    frameRecord(buffer, payload);
+}
+
+void FileManager::formatDeletion(std::string& payload, int id) {
+    payload += "-|";
+    appendInt(payload, id);
+}
+
+bool FileManager::parseDeletion(std::string_view payload, int& id) {
+    if (payload.size() < 3 || payload[0] != '-' || payload[1] != '|') {
+        return false;
+    }
+    return parseInt(payload.substr(2), id);
+}
+
+void FileManager::formatTableGeneration(std::string& buffer, std::uint64_t generation) {
+    buffer += "# generation|";
+    appendInt(buffer, static_cast<long long>(generation));
+    buffer += '\n';
+}
+
+std::uint64_t FileManager::parseTableGeneration(std::string_view data) {
+    constexpr std::string_view prefix = "# generation|";
+    if (data.substr(0, prefix.size()) != prefix) {
+        return 0;
+    }
+
+    std::uint64_t generation = 0;
+    const char* begin = data.data() + prefix.size();
+    auto result = std::from_chars(begin, data.data() + data.size(), generation);
+    return (result.ec == std::errc()) ? generation : 0;
+}
+
+void FileManager::frameJournalGeneration(std::string& buffer, std::uint64_t generation) {
+    std::string payload = "=|";
+    appendInt(payload, static_cast<long long>(generation));
+    frameRecord(buffer, payload);
+}
+
+bool FileManager::parseJournalGeneration(std::string_view payload, std::uint64_t& generation) {
+    if (payload.size() < 3 || payload[0] != '=' || payload[1] != '|') {
+        return false;
+    }
+
+    const char* end = payload.data() + payload.size();
+    auto result = std::from_chars(payload.data() + 2, end, generation);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+std::vector<std::string> FileManager::readRecords(const std::string& filename) const {
+    std::vector<std::string> records;
+
+    // Frames are read from the raw bytes: trimming lines would change
+    // payloads that begin or end with whitespace and break their checksum
+    MappedFile file = mapFile(filename);
+    scanFrames(file.data(), [&records](std::string_view payload) {
+        records.emplace_back(payload);
+    });
+
+    return records;
+}
+
+bool FileManager::truncateRecords(const std::string& filename) const {
+    std::size_t intact = 0;
+    std::size_t size = 0;
+    {
+        MappedFile file = mapFile(filename);
+        if (!file.isOpen()) {
+            return true;
+        }
+        size = file.data().size();
+        intact = scanFrames(file.data(), [](std::string_view) {});
+    }
+
+    if (intact == size) {
+        return true;
+    }
+
+    std::string fullPath = m_dataPath + filename;
+#ifdef _WIN32
+    std::error_code error;
+    fs::resize_file(fullPath, intact, error);
+    return !error;
+#else
+    int fd = ::open(fullPath.c_str(), O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    bool truncated = ::ftruncate(fd, static_cast<off_t>(intact)) == 0 && ::fsync(fd) == 0;
+    return (::close(fd) == 0) && truncated;
+#endif
+}
+
 std::vector<std::string> FileManager::splitLine(const std::string& line, char delimiter) {
     std::vector<std::string> fields;
     std::stringstream ss(line);
@@ -132,3 +447,144 @@ std::string FileManager::trim(const std::string& str) {
     const auto end = str.find_last_not_of(" \t\r\n");
     return str.substr(start, end - start + 1);
 }
+
+std::string_view FileManager::trimView(std::string_view str) {
+    const auto start = str.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) {
+        return std::string_view();
+    }
+
+    const auto end = str.find_last_not_of(" \t\r\n");
+    return str.substr(start, end - start + 1);
+}
+
+std::size_t FileManager::splitFields(std::string_view line, char delimiter,
+                                     std::string_view* fields, std::size_t maxFields) {
+    std::size_t count = 0;
+    if (line.empty()) {
+        return count;
+    }
+
+    std::size_t start = 0;
+    while (count < maxFields) {
+        const auto end = line.find(delimiter, start);
+        if (end == std::string_view::npos) {
+            fields[count++] = trimView(line.substr(start));
+            break;
+        }
+        fields[count++] = trimView(line.substr(start, end - start));
+        start = end + 1;
+    }
+
+    return count;
+}
+
+bool FileManager::parseInt(std::string_view field, int& value) {
+    const char* end = field.data() + field.size();
+    auto result = std::from_chars(field.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end && !field.empty();
+}
+
+bool FileManager::parseUInt32(std::string_view field, std::uint32_t& value) {
+    const char* end = field.data() + field.size();
+    auto result = std::from_chars(field.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end && !field.empty();
+}
+
+bool FileManager::parseDouble(std::string_view field, double& value) {
+    if (field.empty()) {
+        return false;
+    }
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const char* end = field.data() + field.size();
+    auto result = std::from_chars(field.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+#else
+    // Standard libraries without floating-point from_chars: strtod on a
+    // stack copy (fields are short, so no heap allocation is needed)
+    char buffer[64];
+    if (field.size() >= sizeof(buffer)) {
+        return false;
+    }
+    std::memcpy(buffer, field.data(), field.size());
+    buffer[field.size()] = '\0';
+
+    char* end = nullptr;
+    value = std::strtod(buffer, &end);
+    return end == buffer + field.size();
+#endif
+}
+
+bool FileManager::parseMoney(std::string_view field, Money& value) {
+    const char* end = field.data() + field.size();
+    auto result = std::from_chars(field.data(), end, value);
+    if (result.ec == std::errc() && result.ptr == end && !field.empty()) {
+        return true;
+    }
+
+    double legacy = 0.0;
+    if (!parseDouble(field, legacy)) {
+        return false;
+    }
+    value = static_cast<Money>(std::llround(legacy));
+    return true;
+}
+
+void FileManager::appendInt(std::string& buffer, long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+void FileManager::appendDouble(std::string& buffer, double value) {
+    char digits[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+#else
+    // 17 significant digits always round-trip, just not always shortest
+    int length = std::snprintf(digits, sizeof(digits), "%.17g", value);
+    buffer.append(digits, static_cast<std::size_t>(length));
+#endif
+}
+
+std::uint32_t FileManager::checksum(std::string_view data) {
+    // Slicing-by-8: table[k] advances a byte through k further zero bytes,
+    // so eight bytes are folded per step (the state image is hundreds of MB)
+    static const std::array<std::array<std::uint32_t, 256>, 8> table = [] {
+        std::array<std::array<std::uint32_t, 256>, 8> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            t[0][i] = c;
+        }
+        for (std::size_t k = 1; k < 8; ++k) {
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                t[k][i] = t[0][t[k - 1][i] & 0xFF] ^ (t[k - 1][i] >> 8);
+            }
+        }
+        return t;
+    }();
+
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    std::size_t remaining = data.size();
+    std::uint32_t crc = 0xFFFFFFFFu;
+
+    for (; remaining >= 8; bytes += 8, remaining -= 8) {
+        std::uint32_t low = crc ^ (static_cast<std::uint32_t>(bytes[0]) |
+                                   static_cast<std::uint32_t>(bytes[1]) << 8 |
+                                   static_cast<std::uint32_t>(bytes[2]) << 16 |
+                                   static_cast<std::uint32_t>(bytes[3]) << 24);
+        crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^
+              table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24] ^
+              table[3][bytes[4]] ^ table[2][bytes[5]] ^
+              table[1][bytes[6]] ^ table[0][bytes[7]];
+    }
+    for (; remaining > 0; ++bytes, --remaining) {
+        crc = table[0][(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
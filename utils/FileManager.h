@@ -10,7 +10,12 @@
 #ifndef FILEMANAGER_H
 #define FILEMANAGER_H
 
+#include "MappedFile.h"
+#include "Money.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -54,13 +59,47 @@ public:
     std::vector<std::string> readLines(const std::string& filename) const;
 
     /**
-     * @brief Writes lines to a file (overwrites existing content)
+     * @brief Memory-maps a file for zero-copy line iteration
+     * @param filename Name of the file (relative to data path)
+     * @return Mapped file whose lines are trimmed string_views with
+     *         blank lines and comments skipped (closed if missing)
+     */
+    MappedFile mapFile(const std::string& filename) const;
+
+    /**
+     * @brief Writes lines to a file (atomically replaces existing content)
      * @param filename Name of the file (relative to data path)
      * @param lines Vector of lines to write
      * @return true if successful, false otherwise
      */
     bool writeLines(const std::string& filename, const std::vector<std::string>& lines) const;
 
+    /**
+     * @brief Writes a pre-serialized buffer to a file (atomically replaces existing content)
+     * @param filename Name of the file (relative to data path)
+     * @param data Complete file content, newline-terminated records
+     * @return true if successful, false otherwise
+     *
+     * The data goes to "<filename>.tmp", is fsync'd, and is renamed over
+     * the target, then the directory is fsync'd. A crash or power cut
+     * leaves either the old or the new file, never a truncated one.
+     * Readers that mapped the old file keep seeing it intact. On Windows
+     * the rename is still atomic, but the data is not explicitly flushed.
+     */
+    bool writeBuffer(const std::string& filename, std::string_view data) const;
+
+    /**
+     * @brief Appends a pre-serialized buffer to a file
+     * @param filename Name of the file (relative to data path)
+     * @param data Bytes to append, e.g. records framed with frameRecord()
+     * @return true if successful, false otherwise
+     *
+     * Returns once the bytes are fsync'd (and, for a new file, its
+     * directory entry), so appended log records survive a power cut.
+     * A failed append is truncated away again.
+     */
+    bool appendBuffer(const std::string& filename, std::string_view data) const;
+
     /**
      * @brief Appends a single line to a file
      * @param filename Name of the file (relative to data path)
@@ -83,6 +122,129 @@ public:
      */
     bool ensureFileExists(const std::string& filename) const;
 
+    /**
+     * @brief Renames a file, replacing any file already at the new name
+     * @param from Current name (relative to data path)
+     * @param to New name (relative to data path)
+     * @return true if successful, false otherwise
+     */
+    bool renameFile(const std::string& from, const std::string& to) const;
+
+    /**
+     * @brief Deletes a file
+     * @param filename Name of the file (relative to data path)
+     * @return true if the file is gone (including if it never existed)
+     */
+    bool removeFile(const std::string& filename) const;
+
+    // ============ Framed Records (Write-Ahead Log) ============
+
+    /**
+     * @brief Appends a framed, checksummed record to a log file
+     * @param filename Name of the log file (relative to data path)
+     * @param payload Record payload (single line, no newlines)
+     * @return true if successful, false otherwise
+     *
+     * Records are written as "@|length|checksum|payload" so that a torn
+     * or corrupted tail can be detected when the log is replayed. Like
+     * appendBuffer(), returns once the record is on disk.
+     */
+    bool appendRecord(const std::string& filename, std::string_view payload) const;
+
+    /**
+     * @brief Reads the intact records from a log file
+     * @param filename Name of the log file (relative to data path)
+     * @return Payloads in write order
+     *
+     * Reading stops at the first record whose frame or checksum does not
+     * match, since everything after a torn write is unreliable. Payloads
+     * are sliced by their length field, so they come back byte for byte,
+     * leading and trailing whitespace included.
+     */
+    std::vector<std::string> readRecords(const std::string& filename) const;
+
+    /**
+     * @brief Cuts a log file back to the end of its last intact record
+     * @param filename Name of the log file (relative to data path)
+     * @return true if the file now ends with an intact record (or is
+     *         empty or missing)
+     *
+     * Call after replaying a log. A record torn by a crash would otherwise
+     * stay in front of everything appended later, and readRecords() would
+     * stop at it and never reach the new records.
+     */
+    bool truncateRecords(const std::string& filename) const;
+
+    /**
+     * @brief Appends one framed record to a buffer, as appendRecord() writes it
+     * @param buffer Buffer to append to
+     * @param payload Record payload (single line, no newlines)
+     */
+    static void frameRecord(std::string& buffer, std::string_view payload);
+
+    /**
+     * @brief Appends a framed "entity deleted" record to a buffer
+     * @param buffer Buffer to append to
+     * @param id ID of the deleted entity
+     *
+     * Journals hold full records (insert or replace) and deletions written
+     * as "-|id". Entity records always start with a digit, so the two
+     * never collide.
+     */
+    static void frameDeletion(std::string& buffer, int id);
+
+    /**
+     * @brief Appends an unframed deletion payload ("-|id") to a buffer
+     * @param payload Buffer to append to
+     * @param id ID of the deleted entity
+     */
+    static void formatDeletion(std::string& payload, int id);
+
+    /**
+     * @brief Recognizes a deletion payload written by frameDeletion()
+     * @param payload Record payload
+     * @param id Receives the deleted ID
+     * @return true if the payload is a deletion
+     */
+    static bool parseDeletion(std::string_view payload, int& id);
+
+    // ============ Table Generations (Journal Compaction) ============
+
+    /**
+     * @brief Appends the header line recording a table file's generation
+     * @param buffer Buffer to append to (the start of the table file)
+     * @param generation Number of times the table has been compacted
+     *
+     * Written as the comment "# generation|N", so line readers skip it.
+     */
+    static void formatTableGeneration(std::string& buffer, std::uint64_t generation);
+
+    /**
+     * @brief Reads the header written by formatTableGeneration()
+     * @param data Raw bytes of the table file
+     * @return Generation, or 0 for a file without the header
+     */
+    static std::uint64_t parseTableGeneration(std::string_view data);
+
+    /**
+     * @brief Appends the framed record that opens a journal ("=|N")
+     * @param buffer Buffer to append to
+     * @param generation Generation of the table the journal applies to
+     *
+     * A journal only applies to the table of the same generation. If a
+     * crash lands a compacted table but not the journal reset after it,
+     * the old journal no longer matches and replay skips it.
+     */
+    static void frameJournalGeneration(std::string& buffer, std::uint64_t generation);
+
+    /**
+     * @brief Recognizes a record written by frameJournalGeneration()
+     * @param payload Record payload
+     * @param generation Receives the generation
+     * @return true if the payload is a generation record
+     */
+    static bool parseJournalGeneration(std::string_view payload, std::uint64_t& generation);
+
     // ============ Parsing Utilities (DRY) ============
 
     /**
@@ -107,6 +269,87 @@ public:
      * @return Trimmed string
      */
     static std::string trim(const std::string& str);
+
+    /**
+     * @brief Trims whitespace from both ends of a view without copying
+     * @param str View to trim
+     * @return Trimmed view into the same characters
+     */
+    static std::string_view trimView(std::string_view str);
+
+    // ============ Allocation-Free Tokenizing (Load Path) ============
+
+    /**
+     * @brief Splits a line into trimmed field views
+     * @param line The line to split
+     * @param delimiter Character to split on
+     * @param fields Caller-provided array receiving the field views
+     * @param maxFields Capacity of the fields array
+     * @return Number of fields stored (at most maxFields)
+     *
+     * Unlike splitLine(), no strings or vectors are allocated; the views
+     * point into line and are only valid while it is alive.
+     */
+    static std::size_t splitFields(std::string_view line, char delimiter,
+                                   std::string_view* fields, std::size_t maxFields);
+
+    /**
+     * @brief Parses a whole field as a base-10 integer
+     * @param field Text to parse
+     * @param value Receives the result on success
+     * @return true if the entire field was a valid integer
+     */
+    static bool parseInt(std::string_view field, int& value);
+
+    /**
+     * @brief Parses a whole field as an unsigned 32-bit integer
+     * @param field Text to parse
+     * @param value Receives the result on success
+     * @return true if the entire field was a valid unsigned integer
+     */
+    static bool parseUInt32(std::string_view field, std::uint32_t& value);
+
+    /**
+     * @brief Parses a whole field as a floating-point number
+     * @param field Text to parse
+     * @param value Receives the result on success
+     * @return true if the entire field was a valid number
+     */
+    static bool parseDouble(std::string_view field, double& value);
+
+    /**
+     * @brief Parses a whole field as an amount of Rupiah
+     * @param field Text to parse
+     * @param value Receives the result on success
+     * @return true if the field was a valid amount
+     *
+     * Files written before money became an integer may hold values like
+     * "18500.5" or "1e+05"; those are rounded to the nearest Rupiah.
+     */
+    static bool parseMoney(std::string_view field, Money& value);
+
+    // ============ Allocation-Free Formatting (Save Path) ============
+
+    /**
+     * @brief Appends an integer in base 10
+     * @param buffer Buffer to append to
+     * @param value Value to format
+     */
+    static void appendInt(std::string& buffer, long long value);
+
+    /**
+     * @brief Appends the shortest text that parses back to exactly value
+     * @param buffer Buffer to append to
+     * @param value Value to format
+     */
+    static void appendDouble(std::string& buffer, double value);
+
+    /**
+     * @brief Computes the CRC-32 checksum of a byte range
+     * @param data Bytes to checksum
+     * @return CRC-32 (IEEE) value
+     */
+    static std::uint32_t checksum(std::string_view data);
 };
 
 #endif // FILEMANAGER_H
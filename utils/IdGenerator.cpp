@@ -4,36 +4,142 @@
  */
 
 #include "IdGenerator.h"
+#include "FileManager.h"
+#include "BackgroundWriter.h"
+#include "BinaryIO.h"
+#include <algorithm>
+#include <limits>
+#include <string>
+
+IdGenerator::IdGenerator() {
+    resetAll();
+}
 
 IdGenerator& IdGenerator::getInstance() {
     static IdGenerator instance;
     return instance;
 }
 
-int IdGenerator::getNextId(const std::string& entityType) {
-    // If counter doesn't exist, it will be initialized to 0
-    return ++m_counters[entityType];
+std::atomic<int>& IdGenerator::counter(EntityType entityType) {
+    return m_counters[static_cast<std::size_t>(entityType)];
+}
+
+const std::atomic<int>& IdGenerator::counter(EntityType entityType) const {
+    return m_counters[static_cast<std::size_t>(entityType)];
+}
+
+int IdGenerator::getNextId(EntityType entityType) {
+    return counter(entityType).fetch_add(1) + 1;
+}
+
+IdBlock IdGenerator::leaseBlock(EntityType entityType, int count) {
+    count = std::max(count, 1);
+
+    // Cut the block short rather than let the counter wrap; block.end must
+    // stay representable too, so INT_MAX itself is never handed out
+    std::atomic<int>& value = counter(entityType);
+    int last = value.load();
+    int granted = 0;
+    do {
+        granted = std::min(count, std::numeric_limits<int>::max() - 1 - last);
+        if (granted <= 0) {
+            return IdBlock();
+        }
+    } while (!value.compare_exchange_weak(last, last + granted));
+
+    IdBlock block;
+    block.next = last + 1;
+    block.end = last + 1 + granted;
+    return block;
 }
 
-void IdGenerator::updateCounter(const std::string& entityType, int id) {
+void IdGenerator::updateCounter(EntityType entityType, int id) {
     // Only update if the provided ID is greater than current counter
-    if (id > m_counters[entityType]) {
-        m_counters[entityType] = id;
+    std::atomic<int>& value = counter(entityType);
+    int current = value.load();
+    while (id > current && !value.compare_exchange_weak(current, id)) {
+        // current now holds the latest value; retry while still lower
     }
 }
 
-int IdGenerator::getCurrentCounter(const std::string& entityType) const {
-    auto it = m_counters.find(entityType);
-    if (it != m_counters.end()) {
-        return it->second;
-    }
-    return 0;
+int IdGenerator::getCurrentCounter(EntityType entityType) const {
+    return counter(entityType).load();
 }
 
-void IdGenerator::resetCounter(const std::string& entityType) {
-    m_counters[entityType] = 0;
+void IdGenerator::resetCounter(EntityType entityType) {
+    counter(entityType).store(0);
 }
 
 void IdGenerator::resetAll() {
-    m_counters.clear();
+    for (auto& value : m_counters) {
+        value.store(0);
+    }
+}
+
+bool IdGenerator::saveToFile(const FileManager& fileManager) const {
+    PendingFile file = snapshot();
+    return fileManager.writeBuffer(file.filename, file.data);
+}
+
+PendingFile IdGenerator::snapshot() const {
+    PendingFile file{FILENAME, std::string()};
+
+    for (std::size_t i = 0; i < ENTITY_TYPE_COUNT; ++i) {
+        file.data += typeName(static_cast<EntityType>(i));
+        file.data += '|';
+        FileManager::appendInt(file.data, m_counters[i].load());
+        file.data += '\n';
+    }
+
+    return file;
+}
+
+bool IdGenerator::loadFromFile(const FileManager& fileManager) {
+    MappedFile file = fileManager.mapFile(FILENAME);
+
+    for (std::string_view line : file) {
+        std::string_view fields[2];
+        EntityType entityType;
+        int id = 0;
+
+        if (FileManager::splitFields(line, '|', fields, 2) == 2 &&
+            parseType(fields[0], entityType) &&
+            FileManager::parseInt(fields[1], id)) {
+            updateCounter(entityType, id);
+        }
+    }
+
+    return true;
+}
+
+void IdGenerator::writeImage(BinaryWriter& writer) const {
+    for (const auto& value : m_counters) {
+        writer.put(static_cast<std::int32_t>(value.load()));
+    }
+}
+
+bool IdGenerator::readImage(BinaryReader& reader) {
+    for (std::size_t i = 0; i < ENTITY_TYPE_COUNT; ++i) {
+        updateCounter(static_cast<EntityType>(i), reader.get<std::int32_t>());
+    }
+    return reader.ok();
+}
+
+const char* IdGenerator::typeName(EntityType entityType) {
+    switch (entityType) {
+        case EntityType::Product:     return "product";
+        case EntityType::Customer:    return "customer";
+        case EntityType::Transaction: return "transaction";
+    }
+    return "";
+}
+
+bool IdGenerator::parseType(std::string_view name, EntityType& entityType) {
+    for (std::size_t i = 0; i < ENTITY_TYPE_COUNT; ++i) {
+        if (name == typeName(static_cast<EntityType>(i))) {
+            entityType = static_cast<EntityType>(i);
+            return true;
+        }
+    }
+    return false;
 }
@@ -9,9 +9,63 @@
 #ifndef IDGENERATOR_H
 #define IDGENERATOR_H
 
+#include <array>
 #include <atomic>
-#include <unordered_map>
-#include <string>
+#include <cstddef>
+#include <string_view>
+
+class FileManager;
+struct PendingFile;
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * @enum EntityType
+ * @brief Kinds of entity that receive IDs
+ */
+enum class EntityType {
+    Product,
+    Customer,
+    Transaction
+};
+
+constexpr std::size_t ENTITY_TYPE_COUNT = 3;  ///< Number of EntityType values
+
+/**
+ * @struct IdBlock
+ * @brief A contiguous range of IDs reserved for one user
+ *
+ * IDs are handed out from [next, end) without touching the shared
+ * counter, so the owner (e.g. one checkout register) never contends with
+ * others. IDs left unused when a block is dropped are simply skipped.
+ */
+struct IdBlock {
+    int next = 0;  ///< Next ID to hand out
+    int end = 0;   ///< One past the last ID in the block
+
+    /**
+     * @brief Takes the next ID from the block
+     * @param id Receives the ID on success
+     * @return false if the block is used up
+     */
+    bool take(int& id) {
+        if (next >= end) {
+            return false;
+        }
+        id = next++;
+        return true;
+    }
+
+    /**
+     * @brief Returns an ID that ended up unused
+     * @param id ID from the latest take()
+     */
+    void putBack(int id) {
+        if (id == next - 1) {
+            next = id;
+        }
+    }
+};
 
 /**
  * @class IdGenerator
@@ -19,14 +73,24 @@
  *
  * This class maintains separate ID counters for each entity type
  * (products, customers, transactions) to ensure unique IDs within
- * each category.
+ * each category. Counters are atomics indexed by EntityType, so IDs can
+ * be drawn from any thread without locking. Counters are saved to
+ * ids.txt so that deleting the newest entity never lets its ID be
+ * handed out again after a restart.
  */
 class IdGenerator {
 private:
-    std::unordered_map<std::string, int> m_counters;  ///< Counters per entity type
+    std::array<std::atomic<int>, ENTITY_TYPE_COUNT> m_counters;  ///< Last ID issued per entity type
+    static constexpr const char* FILENAME = "ids.txt";
 
     // Private constructor for singleton pattern
-    IdGenerator() = default;
+    IdGenerator();
+
+    /**
+     * @brief Gets the counter for an entity type
+     */
+    std::atomic<int>& counter(EntityType entityType);
+    const std::atomic<int>& counter(EntityType entityType) const;
 
 public:
     // Delete copy constructor and assignment operator
@@ -41,10 +105,22 @@ public:
 
     /**
      * @brief Generates the next unique ID for an entity type
-     * @param entityType Type of entity (e.g., "product", "customer", "transaction")
+     * @param entityType Type of entity
      * @return New unique ID
      */
-    int getNextId(const std::string& entityType);
+    int getNextId(EntityType entityType);
+
+    /**
+     * @brief Reserves a block of consecutive IDs
+     * @param entityType Type of entity
+     * @param count Number of IDs to reserve (at least 1)
+     * @return Block covering the reserved IDs; shorter than count near
+     *         INT_MAX, and empty once the counter is exhausted
+     *
+     * The counter moves past the whole block, so a snapshot taken while
+     * it is in use never lets its IDs be handed out again.
+     */
+    IdBlock leaseBlock(EntityType entityType, int count);
 
     /**
      * @brief Updates the counter if a higher ID is found
@@ -54,25 +130,75 @@ public:
      * This is useful when loading existing data to ensure
      * new IDs don't conflict with existing ones.
      */
-    void updateCounter(const std::string& entityType, int id);
+    void updateCounter(EntityType entityType, int id);
 
     /**
      * @brief Gets the current counter value for an entity type
      * @param entityType Type of entity
      * @return Current counter value (0 if not initialized)
      */
-    int getCurrentCounter(const std::string& entityType) const;
+    int getCurrentCounter(EntityType entityType) const;
 
     /**
      * @brief Resets the counter for an entity type
      * @param entityType Type of entity
      */
-    void resetCounter(const std::string& entityType);
+    void resetCounter(EntityType entityType);
 
     /**
      * @brief Resets all counters
      */
     void resetAll();
+
+    // ============ File I/O ============
+
+    /**
+     * @brief Saves all counters to ids.txt
+     * @param fileManager File I/O handler
+     * @return true if successful
+     */
+    bool saveToFile(const FileManager& fileManager) const;
+
+    /**
+     * @brief Serializes all counters for a background save
+     * @return ids.txt content, ready for BackgroundWriter
+     */
+    PendingFile snapshot() const;
+
+    /**
+     * @brief Raises counters to the values saved in ids.txt
+     * @param fileManager File I/O handler
+     * @return true if successful (a missing file is not an error)
+     */
+    bool loadFromFile(const FileManager& fileManager);
+
+    /**
+     * @brief Appends all counters to a state image payload
+     * @param writer Binary writer
+     */
+    void writeImage(BinaryWriter& writer) const;
+
+    /**
+     * @brief Raises counters to the values in a section written by writeImage()
+     * @param reader Binary reader
+     * @return true if the section was complete
+     */
+    bool readImage(BinaryReader& reader);
+
+    /**
+     * @brief Gets the name used for an entity type in ids.txt
+     * @param entityType Type of entity
+     * @return "product", "customer" or "transaction"
+     */
+    static const char* typeName(EntityType entityType);
+
+    /**
+     * @brief Parses an entity type name
+     * @param name Name as written by typeName()
+     * @param entityType Receives the type on success
+     * @return true if the name is known
+     */
+    static bool parseType(std::string_view name, EntityType& entityType);
 };
 
 #endif // IDGENERATOR_H
@@ -0,0 +1,155 @@
+/**
+ * @file JournaledTable.cpp
+ * @brief Implementation of JournaledTable class
+ */
+
+#include "JournaledTable.h"
+#include <algorithm>
+
+JournaledTable::JournaledTable(FileManager& fileManager, const std::string& filename,
+                               const std::string& journalFilename, std::size_t recordSizeHint)
+    : m_fileManager(fileManager)
+    , m_filename(filename)
+    , m_journalFilename(journalFilename)
+    , m_recordSizeHint(recordSizeHint)
+    , m_journalRecords(0)
+    , m_generation(0)
+{
+}
+
+// ============ Change Tracking ============
+
+void JournaledTable::markChanged(int id) {
+    m_changes.markChanged(id);
+}
+
+void JournaledTable::markRemoved(int id) {
+    m_changes.markRemoved(id);
+}
+
+void JournaledTable::requireFullSave() {
+    m_changes.requireFullSave();
+}
+
+bool JournaledTable::hasChanges() const {
+    return m_changes.hasChanges();
+}
+
+// ============ Loading ============
+
+MappedFile JournaledTable::open() {
+    MappedFile file = m_fileManager.mapFile(m_filename);
+    m_generation = FileManager::parseTableGeneration(file.data());
+    return file;
+}
+
+void JournaledTable::replay(const ApplyRecord& apply, const RemoveRecord& remove) {
+    m_journalRecords = 0;
+    std::vector<std::string> records = m_fileManager.readRecords(m_journalFilename);
+
+    // A journal from before the last compaction is already in the table.
+    // Replace it, or later appends would be skipped along with it
+    std::uint64_t generation = 0;
+    bool hasGeneration = !records.empty() &&
+                         FileManager::parseJournalGeneration(records.front(), generation);
+    if (generation != m_generation) {
+        m_changes.clear();
+        PendingFile journal = emptyJournal();
+        if (!m_fileManager.writeBuffer(journal.filename, journal.data)) {
+            m_changes.requireFullSave();
+        }
+        return;
+    }
+
+    for (std::size_t i = hasGeneration ? 1 : 0; i < records.size(); ++i) {
+        const std::string& record = records[i];
+        ++m_journalRecords;
+
+        int id = 0;
+        if (FileManager::parseDeletion(record, id)) {
+            remove(id);
+        } else {
+            apply(record);
+        }
+    }
+
+    m_fileManager.truncateRecords(m_journalFilename);
+    m_changes.clear();
+}
+
+void JournaledTable::restore(std::size_t journalRecords) {
+    m_journalRecords = journalRecords;
+    m_generation = FileManager::parseTableGeneration(m_fileManager.mapFile(m_filename).data());
+    m_changes.clear();
+}
+
+std::size_t JournaledTable::getJournalRecords() const {
+    return m_journalRecords;
+}
+
+// ============ Saving ============
+
+PendingFile JournaledTable::emptyJournal() const {
+    PendingFile journal{m_journalFilename, std::string()};
+    FileManager::frameJournalGeneration(journal.data, m_generation);
+    return journal;
+}
+
+PendingFile JournaledTable::snapshot(std::size_t rows, const WriteRows& writeRows) const {
+    PendingFile file{m_filename, std::string()};
+    file.data.reserve(rows * m_recordSizeHint);
+    FileManager::formatTableGeneration(file.data, m_generation);
+    writeRows(file.data);
+    return file;
+}
+
+bool JournaledTable::save(std::size_t rows, const WriteRows& writeRows) {
+    // The new generation retires the current journal even if the reset
+    // below never lands
+    ++m_generation;
+    PendingFile file = snapshot(rows, writeRows);
+    if (!m_fileManager.writeBuffer(file.filename, file.data)) {
+        return false;
+    }
+
+    // Everything in the journal is now part of the table
+    m_changes.clear();
+    m_journalRecords = 0;
+    PendingFile journal = emptyJournal();
+    return m_fileManager.writeBuffer(journal.filename, journal.data);
+}
+
+std::vector<PendingFile> JournaledTable::snapshotChanges(std::size_t rows, const WriteRows& writeRows,
+                                                         const WriteRecord& writeRecord) {
+    ChangeSet changes = m_changes.take();
+    std::size_t deltas = changes.changed.size() + changes.removed.size();
+    if (deltas == 0 && !changes.fullSaveRequired) {
+        return {};
+    }
+
+    // Compact once replaying the journal would cost more than reading the table
+    if (changes.fullSaveRequired || m_journalRecords + deltas > std::max(COMPACT_MIN, rows)) {
+        // Table first: until the journal reset lands, the old journal's
+        // generation no longer matches and replay skips it
+        m_journalRecords = 0;
+        ++m_generation;
+        return {snapshot(rows, writeRows), emptyJournal()};
+    }
+
+    PendingFile journal{m_journalFilename, std::string(), true};
+    journal.data.reserve(deltas * (m_recordSizeHint + 16));
+    std::string payload;
+
+    for (int id : changes.changed) {
+        payload.clear();
+        if (writeRecord(id, payload)) {
+            FileManager::frameRecord(journal.data, payload);
+        }
+    }
+    for (int id : changes.removed) {
+        FileManager::frameDeletion(journal.data, id);
+    }
+
+    m_journalRecords += deltas;
+    return {std::move(journal)};
+}
@@ -0,0 +1,165 @@
+/**
+ * @file JournaledTable.h
+ * @brief Saves a table as a full file plus a journal of changes since
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only decides what to write and in what order;
+ *   the owning controller knows how records are serialized and applied
+ * - DRY: Shared by every controller that saves incrementally
+ */
+
+#ifndef JOURNALEDTABLE_H
+#define JOURNALEDTABLE_H
+
+#include "ChangeTracker.h"
+#include "FileManager.h"
+#include "BackgroundWriter.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @class JournaledTable
+ * @brief Table file, its journal, and the generation tying them together
+ *
+ * Changes are appended to the journal, and the table is only rewritten
+ * (compacted) once replaying the journal would cost more than reading
+ * the table. Every compaction starts a new generation: the table header
+ * carries it, and the journal opens with a generation record. A journal
+ * whose generation differs from the table's is already part of the table
+ * and is never replayed, so a crash between writing the table and
+ * resetting the journal cannot apply old changes twice, and the table
+ * must always be written before its journal.
+ *
+ * The owning controller supplies the serialization through callbacks and
+ * must guard its own data; only the change marks are thread-safe.
+ */
+class JournaledTable {
+public:
+    /// Appends every row of the table, one per line
+    using WriteRows = std::function<void(std::string& data)>;
+    /// Serializes one row; returns false if it no longer exists
+    using WriteRecord = std::function<bool(int id, std::string& payload)>;
+    /// Adds or replaces a row from a journal record
+    using ApplyRecord = std::function<void(const std::string& record)>;
+    /// Removes a row named by a journal deletion
+    using RemoveRecord = std::function<void(int id)>;
+
+private:
+    FileManager& m_fileManager;      ///< File I/O handler
+    std::string m_filename;          ///< Table file
+    std::string m_journalFilename;   ///< Journal file
+    std::size_t m_recordSizeHint;    ///< Typical serialized record length
+    ChangeTracker m_changes;         ///< Rows changed since the last save
+    std::size_t m_journalRecords;    ///< Records in the journal
+    std::uint64_t m_generation;      ///< Compactions of the table; the journal must open with the same
+    static constexpr std::size_t COMPACT_MIN = 1000;  ///< Journal records always allowed before compacting
+
+    /**
+     * @brief Starts a new, empty journal for the current generation
+     * @return Journal content holding only the generation record
+     */
+    PendingFile emptyJournal() const;
+
+public:
+    /**
+     * @brief Constructs a table with nothing loaded
+     * @param fileManager Reference to FileManager for I/O
+     * @param filename Table file
+     * @param journalFilename Journal file
+     * @param recordSizeHint Typical serialized record length
+     */
+    JournaledTable(FileManager& fileManager, const std::string& filename,
+                   const std::string& journalFilename, std::size_t recordSizeHint);
+
+    // ============ Change Tracking ============
+
+    /**
+     * @brief Records that a row was added or modified
+     * @param id Row ID
+     */
+    void markChanged(int id);
+
+    /**
+     * @brief Records that a row was removed
+     * @param id Row ID
+     */
+    void markRemoved(int id);
+
+    /**
+     * @brief Makes the next snapshotChanges() rewrite the table
+     *
+     * Call when a save failed, since its changes were already taken.
+     */
+    void requireFullSave();
+
+    /**
+     * @brief Checks whether anything changed since the last save
+     * @return true if there is something to save
+     */
+    bool hasChanges() const;
+
+    // ============ Loading ============
+
+    /**
+     * @brief Maps the table file and takes its generation
+     * @return Table content; the header line is skipped by its iterator
+     */
+    MappedFile open();
+
+    /**
+     * @brief Applies the journal on top of the rows read from open()
+     * @param apply Adds or replaces a row
+     * @param remove Removes a row
+     *
+     * Afterwards nothing counts as changed: what was replayed is already
+     * on disk.
+     */
+    void replay(const ApplyRecord& apply, const RemoveRecord& remove);
+
+    /**
+     * @brief Takes the table state back from a state image
+     * @param journalRecords Journal length recorded in the image
+     */
+    void restore(std::size_t journalRecords);
+
+    /**
+     * @brief Gets the journal length, for a state image
+     * @return Records in the journal
+     */
+    std::size_t getJournalRecords() const;
+
+    // ============ Saving ============
+
+    /**
+     * @brief Serializes the whole table under the current generation
+     * @param rows Number of rows, to size the buffer
+     * @param writeRows Appends every row
+     * @return Table file content, ready for BackgroundWriter
+     */
+    PendingFile snapshot(std::size_t rows, const WriteRows& writeRows) const;
+
+    /**
+     * @brief Rewrites the table and empties the journal, synchronously
+     * @param rows Number of rows
+     * @param writeRows Appends every row
+     * @return true if both files were written
+     */
+    bool save(std::size_t rows, const WriteRows& writeRows);
+
+    /**
+     * @brief Serializes only what changed since the last save
+     * @param rows Number of rows
+     * @param writeRows Appends every row
+     * @param writeRecord Serializes one changed row
+     * @return Files for BackgroundWriter: nothing, a journal append, or
+     *         (when the journal is due for compaction) a full rewrite
+     *         under a new generation followed by an emptied journal
+     */
+    std::vector<PendingFile> snapshotChanges(std::size_t rows, const WriteRows& writeRows,
+                                             const WriteRecord& writeRecord);
+};
+
+#endif // JOURNALEDTABLE_H
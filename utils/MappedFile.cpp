@@ -0,0 +1,153 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of MappedFile class
+ */
+
+#include "MappedFile.h"
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::LineIterator::LineIterator(const char* begin, const char* end)
+    : m_cursor(begin)
+    , m_end(end)
+    , m_line()
+{
+    if (m_cursor) {
+        advance();
+    }
+}
+
+void MappedFile::LineIterator::advance() {
+    while (m_cursor && m_cursor < m_end) {
+        const char* newline = static_cast<const char*>(
+            std::memchr(m_cursor, '\n', static_cast<std::size_t>(m_end - m_cursor)));
+        const char* lineEnd = newline ? newline : m_end;
+
+        const char* start = m_cursor;
+        m_cursor = newline ? newline + 1 : m_end;
+
+        // Trim in place, matching FileManager::trim
+        while (start < lineEnd && std::strchr(" \t\r", *start)) ++start;
+        while (lineEnd > start && std::strchr(" \t\r", *(lineEnd - 1))) --lineEnd;
+
+        // Skip empty lines and comments (lines starting with #)
+        if (start != lineEnd && *start != '#') {
+            m_line = std::string_view(start, static_cast<std::size_t>(lineEnd - start));
+            return;
+        }
+    }
+
+    m_line = std::string_view();
+}
+
+MappedFile::MappedFile()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_open(false)
+{
+}
+
+MappedFile::MappedFile(const std::string& path)
+    : m_data(nullptr)
+    , m_size(0)
+    , m_open(false)
+{
+#ifdef _WIN32
+    // No mmap: read the file into a single buffer (still one copy in total)
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+
+    m_size = static_cast<std::size_t>(file.tellg());
+    m_buffer.reset(new char[m_size + 1]);
+    file.seekg(0);
+    file.read(m_buffer.get(), static_cast<std::streamsize>(m_size));
+    m_data = m_buffer.get();
+    m_open = true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0) {
+        m_open = true;
+        m_size = static_cast<std::size_t>(info.st_size);
+
+        if (m_size > 0) {
+            void* mapped = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                ::madvise(mapped, m_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char*>(mapped);
+            } else {
+                m_open = false;
+                m_size = 0;
+            }
+        }
+    }
+
+    ::close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_open(std::exchange(other.m_open, false))
+    , m_buffer(std::move(other.m_buffer))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_open = std::exchange(other.m_open, false);
+        m_buffer = std::move(other.m_buffer);
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+#ifndef _WIN32
+    if (m_data && !m_buffer) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_buffer.reset();
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+bool MappedFile::isOpen() const {
+    return m_open;
+}
+
+std::string_view MappedFile::data() const {
+    return m_data ? std::string_view(m_data, m_size) : std::string_view();
+}
+
+MappedFile::LineIterator MappedFile::begin() const {
+    return LineIterator(m_data, m_data + m_size);
+}
+
+MappedFile::LineIterator MappedFile::end() const {
+    return LineIterator(nullptr, nullptr);
+}
@@ -0,0 +1,126 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory-mapped view of a data file
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only maps a file and walks its lines
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @class MappedFile
+ * @brief Maps a whole file into memory and iterates its data lines
+ *
+ * Lines are yielded as std::string_view slices directly over the mapped
+ * bytes, trimmed, with blank lines and '#' comments skipped, so large
+ * data files can be parsed without copying them onto the heap. Views are
+ * only valid while the MappedFile is alive.
+ */
+class MappedFile {
+private:
+    const char* m_data;                ///< Start of the mapped bytes
+    std::size_t m_size;                ///< Number of mapped bytes
+    bool m_open;                       ///< Whether the file could be opened
+    std::unique_ptr<char[]> m_buffer;  ///< Fallback copy where mmap is unavailable
+
+    /**
+     * @brief Releases the mapping (if any)
+     */
+    void release();
+
+public:
+    /**
+     * @class LineIterator
+     * @brief Forward iterator over the data lines of a MappedFile
+     */
+    class LineIterator {
+    private:
+        const char* m_cursor;     ///< Start of the next unread line
+        const char* m_end;        ///< End of the mapped bytes
+        std::string_view m_line;  ///< Current line (data() is nullptr at end)
+
+        /**
+         * @brief Moves to the next non-blank, non-comment line
+         */
+        void advance();
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        /**
+         * @brief Constructs an iterator over [begin, end)
+         * @param begin First byte (nullptr for the end iterator)
+         * @param end One past the last byte
+         */
+        LineIterator(const char* begin, const char* end);
+
+        reference operator*() const { return m_line; }
+        pointer operator->() const { return &m_line; }
+        LineIterator& operator++() { advance(); return *this; }
+        LineIterator operator++(int) { LineIterator tmp = *this; advance(); return tmp; }
+
+        bool operator==(const LineIterator& other) const { return m_line.data() == other.m_line.data(); }
+        bool operator!=(const LineIterator& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Constructs a closed, empty MappedFile (assign a mapping later)
+     */
+    MappedFile();
+
+    /**
+     * @brief Maps the file at the given path
+     * @param path Full path to the file
+     *
+     * A missing file yields a closed, empty MappedFile.
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * @brief Unmaps the file
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Checks if the file was opened
+     * @return true if the file exists and could be read
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Gets the raw mapped bytes
+     * @return View over the whole file
+     */
+    std::string_view data() const;
+
+    /**
+     * @brief Gets an iterator to the first data line
+     * @return Line iterator
+     */
+    LineIterator begin() const;
+
+    /**
+     * @brief Gets the end line iterator
+     * @return Line iterator
+     */
+    LineIterator end() const;
+};
+
+#endif // MAPPEDFILE_H
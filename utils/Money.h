@@ -0,0 +1,19 @@
+/**
+ * @file Money.h
+ * @brief Fixed-point money type
+ */
+
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstdint>
+
+/**
+ * @brief An amount of money in whole Rupiah
+ *
+ * Rupiah prices carry no minor unit, so every price, subtotal, discount
+ * and total fits in a 64-bit integer and sums of any length are exact.
+ */
+using Money = std::int64_t;
+
+#endif // MONEY_H
@@ -0,0 +1,154 @@
+/**
+ * @file NgramIndex.cpp
+ * @brief Implementation of NgramIndex class
+ */
+
+#include "NgramIndex.h"
+#include <algorithm>
+#include <tuple>
+
+std::uint32_t NgramIndex::gramAt(std::string_view text, std::size_t pos) {
+    return (static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos])) << 16) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8) |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+}
+
+int NgramIndex::rank(std::string_view text, std::string_view query) {
+    std::size_t pos = text.find(query);
+    if (pos == std::string_view::npos) {
+        return -1;
+    }
+    if (pos == 0) {
+        return 0;
+    }
+
+    // Prefer a later occurrence at the start of a word ("ani" in "Siti Aniyah")
+    for (; pos != std::string_view::npos; pos = text.find(query, pos + 1)) {
+        if (text[pos - 1] == ' ') {
+            return 1;
+        }
+    }
+    return 2;
+}
+
+void NgramIndex::insert(int id, std::string_view text) {
+    erase(id);
+
+    std::string folded = fold(text);
+    if (folded.size() >= GRAM_SIZE) {
+        for (std::size_t i = 0; i + GRAM_SIZE <= folded.size(); ++i) {
+            std::vector<int>& ids = m_postings[gramAt(folded, i)];
+            auto it = std::lower_bound(ids.begin(), ids.end(), id);
+            if (it == ids.end() || *it != id) {
+                ids.insert(it, id);
+            }
+        }
+    }
+
+    m_texts.emplace(id, std::move(folded));
+}
+
+bool NgramIndex::erase(int id) {
+    auto textIt = m_texts.find(id);
+    if (textIt == m_texts.end()) {
+        return false;
+    }
+
+    const std::string& folded = textIt->second;
+    if (folded.size() >= GRAM_SIZE) {
+        for (std::size_t i = 0; i + GRAM_SIZE <= folded.size(); ++i) {
+            auto postingIt = m_postings.find(gramAt(folded, i));
+            if (postingIt == m_postings.end()) {
+                continue;
+            }
+
+            std::vector<int>& ids = postingIt->second;
+            auto it = std::lower_bound(ids.begin(), ids.end(), id);
+            if (it != ids.end() && *it == id) {
+                ids.erase(it);
+            }
+            if (ids.empty()) {
+                m_postings.erase(postingIt);
+            }
+        }
+    }
+
+    m_texts.erase(textIt);
+    return true;
+}
+
+std::vector<int> NgramIndex::search(std::string_view query, std::size_t limit) const {
+    std::string folded = fold(query);
+    std::vector<std::tuple<int, std::size_t, int>> matches;  // rank, length, id
+
+    auto consider = [&](int id, const std::string& text) {
+        int score = rank(text, folded);
+        if (score >= 0) {
+            matches.emplace_back(score, text.size(), id);
+        }
+    };
+
+    if (folded.size() < GRAM_SIZE) {
+        for (const auto& entry : m_texts) {
+            consider(entry.first, entry.second);
+        }
+    } else {
+        // Intersect postings smallest-first; any missing trigram means no match
+        std::vector<const std::vector<int>*> lists;
+        for (std::size_t i = 0; i + GRAM_SIZE <= folded.size(); ++i) {
+            auto it = m_postings.find(gramAt(folded, i));
+            if (it == m_postings.end()) {
+                return {};
+            }
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(),
+            [](const std::vector<int>* a, const std::vector<int>* b) {
+                return a->size() < b->size();
+            });
+
+        std::vector<int> candidates = *lists.front();
+        std::vector<int> narrowed;
+        for (std::size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+            if (lists[i] == lists[i - 1]) {
+                continue;
+            }
+            narrowed.clear();
+            std::set_intersection(candidates.begin(), candidates.end(),
+                                  lists[i]->begin(), lists[i]->end(),
+                                  std::back_inserter(narrowed));
+            candidates.swap(narrowed);
+        }
+
+        // Trigrams can all be present without the query being a substring
+        for (int id : candidates) {
+            consider(id, m_texts.at(id));
+        }
+    }
+
+    std::size_t count = (limit == 0) ? matches.size() : std::min(limit, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + static_cast<std::ptrdiff_t>(count),
+                      matches.end());
+
+    std::vector<int> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(std::get<2>(matches[i]));
+    }
+    return result;
+}
+
+void NgramIndex::clear() {
+    m_postings.clear();
+    m_texts.clear();
+}
+
+std::string NgramIndex::fold(std::string_view text) {
+    std::string folded(text);
+    for (char& c : folded) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return folded;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file NgramIndex.h
+ * @brief Trigram inverted index for case-insensitive substring search
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only maps text fragments to the IDs containing them
+ */
+
+#ifndef NGRAMINDEX_H
+#define NGRAMINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class NgramIndex
+ * @brief Finds IDs whose text contains a query, ranked by match quality
+ *
+ * Text is folded to lowercase once on insert. Every three-character window
+ * of the folded text has a sorted posting list of IDs, so a query only
+ * intersects the postings of its own trigrams and then confirms the few
+ * surviving candidates with a substring check. Queries shorter than three
+ * characters fall back to scanning the folded texts, which still avoids
+ * re-folding on every call.
+ */
+class NgramIndex {
+private:
+    static constexpr std::size_t GRAM_SIZE = 3;
+
+    std::unordered_map<std::uint32_t, std::vector<int>> m_postings;  ///< Trigram -> sorted IDs
+    std::unordered_map<int, std::string> m_texts;                    ///< ID -> folded text
+
+    /**
+     * @brief Packs the trigram starting at a position into one key
+     * @param text Folded text
+     * @param pos Start of the trigram
+     * @return Packed trigram
+     */
+    static std::uint32_t gramAt(std::string_view text, std::size_t pos);
+
+    /**
+     * @brief Scores how well a query matches a folded text
+     * @param text Folded text
+     * @param query Folded query
+     * @return Lower is better, -1 if the query does not occur
+     */
+    static int rank(std::string_view text, std::string_view query);
+
+public:
+    /**
+     * @brief Adds or replaces the text for an ID
+     * @param id Entity ID
+     * @param text Text to index
+     */
+    void insert(int id, std::string_view text);
+
+    /**
+     * @brief Removes an ID from the index
+     * @param id Entity ID
+     * @return true if the ID was indexed
+     */
+    bool erase(int id);
+
+    /**
+     * @brief Finds IDs whose text contains the query
+     * @param query Search text (case-insensitive)
+     * @param limit Maximum number of results (0 for no limit)
+     * @return IDs ordered by rank: prefix matches, then word starts, then
+     *         other substrings; ties go to the shorter text, then lower ID
+     */
+    std::vector<int> search(std::string_view query, std::size_t limit = 0) const;
+
+    /**
+     * @brief Removes all entries
+     */
+    void clear();
+
+    /**
+     * @brief Lowercases ASCII letters
+     * @param text Text to fold
+     * @return Folded copy
+     */
+    static std::string fold(std::string_view text);
+};
+
+#endif // NGRAMINDEX_H
@@ -0,0 +1,81 @@
+/**
+ * @file SalesAggregates.cpp
+ * @brief Implementation of SalesAggregates class
+ */
+
+#include "SalesAggregates.h"
+#include "DateTime.h"
+
+void SalesAggregates::apply(const Transaction& transaction, int sign) {
+    Money total = sign * transaction.getTotal();
+    int units = sign * transaction.getItemCount();
+
+    auto addTo = [sign](SalesTotals& totals, Money revenue, int items) {
+        totals.revenue += revenue;
+        totals.transactions += sign;
+        totals.itemsSold += items;
+    };
+
+    std::int64_t timestamp = transaction.getTimestamp();
+    std::int64_t day = DateTime::startOfDay(timestamp);
+    std::size_t hour = static_cast<std::size_t>((timestamp - day) / DateTime::SECONDS_PER_HOUR);
+
+    addTo(m_overall, total, units);
+    addTo(m_byDay[day], total, units);
+    addTo(m_byHour[hour], total, units);
+    addTo(m_byCustomer[transaction.getCustomerId()], total, units);
+
+    for (const auto& item : transaction.getItems()) {
+        addTo(m_byProduct[item.getProductId()], sign * item.getSubtotal(),
+              sign * item.getQuantity());
+    }
+}
+
+void SalesAggregates::add(const Transaction& transaction) {
+    apply(transaction, 1);
+}
+
+void SalesAggregates::remove(const Transaction& transaction) {
+    apply(transaction, -1);
+}
+
+void SalesAggregates::clear() {
+    m_overall = SalesTotals();
+    m_byDay.clear();
+    m_byHour.fill(SalesTotals());
+    m_byProduct.clear();
+    m_byCustomer.clear();
+}
+
+// ============ Getters ============
+
+const SalesTotals& SalesAggregates::getOverall() const {
+    return m_overall;
+}
+
+SalesTotals SalesAggregates::getDay(std::int64_t timestamp) const {
+    return lookup(m_byDay, DateTime::startOfDay(timestamp));
+}
+
+SalesTotals SalesAggregates::getHour(int hour) const {
+    if (hour < 0 || hour >= 24) {
+        return SalesTotals();
+    }
+    return m_byHour[static_cast<std::size_t>(hour)];
+}
+
+SalesTotals SalesAggregates::getProduct(int productId) const {
+    return lookup(m_byProduct, productId);
+}
+
+SalesTotals SalesAggregates::getCustomer(int customerId) const {
+    return lookup(m_byCustomer, customerId);
+}
+
+const std::unordered_map<std::int64_t, SalesTotals>& SalesAggregates::getByDay() const {
+    return m_byDay;
+}
+
+const std::unordered_map<int, SalesTotals>& SalesAggregates::getByProduct() const {
+    return m_byProduct;
+}
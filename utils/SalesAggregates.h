@@ -0,0 +1,100 @@
+/**
+ * @file SalesAggregates.h
+ * @brief Running sales totals maintained as transactions are recorded
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only keeps derived sales totals
+ * - Open/Closed: New breakdowns can be added without touching the controller
+ */
+
+#ifndef SALESAGGREGATES_H
+#define SALESAGGREGATES_H
+
+#include "../models/Transaction.h"
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * @struct SalesTotals
+ * @brief Revenue and volume for one bucket (a day, an hour, a product...)
+ */
+struct SalesTotals {
+    Money revenue = 0;     ///< Amount charged
+    int transactions = 0;  ///< Number of transactions contributing
+    int itemsSold = 0;     ///< Units sold
+};
+
+/**
+ * @class SalesAggregates
+ * @brief Totals by day, hour of day, product and customer
+ *
+ * Each transaction is folded in once when it is recorded, so reading any
+ * total is a lookup instead of a scan over the history. Transaction and
+ * day/hour/customer revenue is the final total after discount; product
+ * revenue is the item subtotal, since discounts apply to the whole bill.
+ */
+class SalesAggregates {
+private:
+    SalesTotals m_overall;                                     ///< All transactions
+    std::unordered_map<std::int64_t, SalesTotals> m_byDay;     ///< Start of day -> totals
+    std::array<SalesTotals, 24> m_byHour;                      ///< Hour of day -> totals
+    std::unordered_map<int, SalesTotals> m_byProduct;          ///< Product ID -> totals
+    std::unordered_map<int, SalesTotals> m_byCustomer;         ///< Customer ID -> totals
+
+    /**
+     * @brief Adds or subtracts a transaction from every bucket
+     * @param transaction Transaction to apply
+     * @param sign 1 to add, -1 to subtract
+     */
+    void apply(const Transaction& transaction, int sign);
+
+    /**
+     * @brief Looks up a bucket, returning zeros if absent
+     */
+    template<typename Key>
+    static SalesTotals lookup(const std::unordered_map<Key, SalesTotals>& map, Key key) {
+        auto it = map.find(key);
+        return (it != map.end()) ? it->second : SalesTotals();
+    }
+
+public:
+    /**
+     * @brief Adds a recorded transaction to the totals
+     * @param transaction Transaction to add
+     */
+    void add(const Transaction& transaction);
+
+    /**
+     * @brief Removes a previously added transaction from the totals
+     * @param transaction Transaction to remove (as it was when added)
+     */
+    void remove(const Transaction& transaction);
+
+    /**
+     * @brief Resets all totals to zero
+     */
+    void clear();
+
+    // ============ Getters ============
+    const SalesTotals& getOverall() const;
+
+    /**
+     * @brief Gets totals for the day containing a timestamp
+     * @param timestamp Any time within the day
+     */
+    SalesTotals getDay(std::int64_t timestamp) const;
+
+    /**
+     * @brief Gets totals for one hour of the day across all days
+     * @param hour Hour of day (0-23)
+     */
+    SalesTotals getHour(int hour) const;
+
+    SalesTotals getProduct(int productId) const;
+    SalesTotals getCustomer(int customerId) const;
+    const std::unordered_map<std::int64_t, SalesTotals>& getByDay() const;
+    const std::unordered_map<int, SalesTotals>& getByProduct() const;
+};
+
+#endif // SALESAGGREGATES_H
@@ -0,0 +1,214 @@
+/**
+ * @file SlotMap.h
+ * @brief Dense storage with stable generational handles
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only stores values and resolves handles
+ * - Open/Closed: Template works for any copyable entity type
+ */
+
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct SlotHandle
+ * @brief Stable reference to a value stored in a SlotMap
+ *
+ * A handle stays valid across any number of inserts and erases of other
+ * values. Once its own value is erased the slot's generation changes, so
+ * the stale handle resolves to nullptr instead of to a different value.
+ */
+struct SlotHandle {
+    std::uint32_t index = UINT32_MAX;  ///< Slot index
+    std::uint32_t generation = 0;      ///< Generation the slot had at insert
+
+    bool operator==(const SlotHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+
+    /**
+     * @brief Checks if the handle was ever assigned
+     * @return false for a default-constructed handle
+     */
+    bool isNull() const { return index == UINT32_MAX; }
+};
+
+/**
+ * @class SlotMap
+ * @brief Slot map with O(1) insert, erase and handle lookup
+ *
+ * Values live contiguously in a dense vector for fast scans. Erasing moves
+ * the last value into the hole, so dense order is insertion order only
+ * until the first erase. Raw pointers into the map are invalidated by
+ * insert and erase; hold a SlotHandle to keep a reference across mutations.
+ *
+ * @tparam T Stored value type
+ */
+template<typename T>
+class SlotMap {
+private:
+    struct Slot {
+        std::uint32_t denseIndex;  ///< Position in m_values while occupied
+        std::uint32_t generation;  ///< Bumped every time the slot is freed
+    };
+
+    std::vector<T> m_values;                 ///< Dense values
+    std::vector<std::uint32_t> m_owners;     ///< Dense position -> slot index
+    std::vector<Slot> m_slots;               ///< Slot table
+    std::vector<std::uint32_t> m_freeSlots;  ///< Reusable slot indices
+
+    SlotHandle allocate() {
+        std::uint32_t slotIndex;
+        if (!m_freeSlots.empty()) {
+            slotIndex = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            slotIndex = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.push_back(Slot{0, 0});
+        }
+
+        m_slots[slotIndex].denseIndex = static_cast<std::uint32_t>(m_values.size());
+        m_owners.push_back(slotIndex);
+        return SlotHandle{slotIndex, m_slots[slotIndex].generation};
+    }
+
+public:
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    /**
+     * @brief Stores a value
+     * @param value Value to copy in
+     * @return Handle to the stored value
+     */
+    SlotHandle insert(const T& value) {
+        SlotHandle handle = allocate();
+        m_values.push_back(value);
+        return handle;
+    }
+
+    /**
+     * @brief Stores a value
+     * @param value Value to move in
+     * @return Handle to the stored value
+     */
+    SlotHandle insert(T&& value) {
+        SlotHandle handle = allocate();
+        m_values.push_back(std::move(value));
+        return handle;
+    }
+
+    /**
+     * @brief Erases the value a handle refers to
+     * @param handle Handle to erase
+     * @return true if the handle was live and its value was erased
+     */
+    bool erase(SlotHandle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+
+        std::uint32_t hole = m_slots[handle.index].denseIndex;
+        std::uint32_t last = static_cast<std::uint32_t>(m_values.size() - 1);
+
+        if (hole != last) {
+            m_values[hole] = std::move(m_values[last]);
+            m_owners[hole] = m_owners[last];
+            m_slots[m_owners[hole]].denseIndex = hole;
+        }
+        m_values.pop_back();
+        m_owners.pop_back();
+
+        ++m_slots[handle.index].generation;
+        m_freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    /**
+     * @brief Checks if a handle still refers to a stored value
+     * @param handle Handle to check
+     * @return true if live
+     */
+    bool contains(SlotHandle handle) const {
+        return handle.index < m_slots.size() &&
+               m_slots[handle.index].generation == handle.generation &&
+               m_slots[handle.index].denseIndex < m_owners.size() &&
+               m_owners[m_slots[handle.index].denseIndex] == handle.index;
+    }
+
+    /**
+     * @brief Resolves a handle
+     * @param handle Handle to resolve
+     * @return Pointer to the value, nullptr if the handle is stale
+     */
+    T* get(SlotHandle handle) {
+        return contains(handle) ? &m_values[m_slots[handle.index].denseIndex] : nullptr;
+    }
+
+    /**
+     * @brief Resolves a handle (const)
+     * @param handle Handle to resolve
+     * @return Pointer to the value, nullptr if the handle is stale
+     */
+    const T* get(SlotHandle handle) const {
+        return contains(handle) ? &m_values[m_slots[handle.index].denseIndex] : nullptr;
+    }
+
+    /**
+     * @brief Gets the handle of the value at a dense position
+     * @param position Position in values()
+     * @return Handle to that value
+     */
+    SlotHandle handleAt(std::size_t position) const {
+        std::uint32_t slotIndex = m_owners[position];
+        return SlotHandle{slotIndex, m_slots[slotIndex].generation};
+    }
+
+    /**
+     * @brief Removes all values and invalidates every outstanding handle
+     */
+    void clear() {
+        m_values.clear();
+        m_owners.clear();
+        m_freeSlots.clear();
+        for (std::uint32_t i = 0; i < m_slots.size(); ++i) {
+            ++m_slots[i].generation;
+            m_freeSlots.push_back(i);
+        }
+    }
+
+    /**
+     * @brief Reserves space for a number of values
+     * @param capacity Expected value count
+     */
+    void reserve(std::size_t capacity) {
+        m_values.reserve(capacity);
+        m_owners.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    std::size_t size() const { return m_values.size(); }
+    bool empty() const { return m_values.empty(); }
+
+    /**
+     * @brief Gets the dense values for contiguous iteration
+     * @return Vector of all stored values
+     */
+    const std::vector<T>& values() const { return m_values; }
+
+    T& operator[](std::size_t position) { return m_values[position]; }
+    const T& operator[](std::size_t position) const { return m_values[position]; }
+
+    iterator begin() { return m_values.begin(); }
+    iterator end() { return m_values.end(); }
+    const_iterator begin() const { return m_values.begin(); }
+    const_iterator end() const { return m_values.end(); }
+};
+
+#endif // SLOTMAP_H
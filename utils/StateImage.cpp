@@ -0,0 +1,120 @@
+/**
+ * @file StateImage.cpp
+ * @brief Implementation of StateImage class
+ */
+
+#include "StateImage.h"
+#include "BinaryIO.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+std::string StateImage::describeSources(const FileManager& fileManager) {
+    struct Stamp {
+        std::string name;
+        std::int64_t size;
+        std::int64_t modified;
+    };
+
+    std::vector<Stamp> stamps;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(fileManager.getDataPath(), error)) {
+        if (!entry.is_regular_file(error)) {
+            continue;
+        }
+
+        std::string name = entry.path().filename().string();
+        bool isTemp = name.size() >= 4 && name.compare(name.size() - 4, 4, ".tmp") == 0;
+        if (name == FILENAME || isTemp) {
+            continue;
+        }
+
+        Stamp stamp{std::move(name), 0, 0};
+        stamp.size = static_cast<std::int64_t>(entry.file_size(error));
+        stamp.modified = static_cast<std::int64_t>(
+            entry.last_write_time(error).time_since_epoch().count());
+        stamps.push_back(std::move(stamp));
+    }
+
+    std::sort(stamps.begin(), stamps.end(),
+        [](const Stamp& a, const Stamp& b) { return a.name < b.name; });
+
+    std::string encoded;
+    BinaryWriter writer(encoded);
+    writer.put(static_cast<std::uint32_t>(stamps.size()));
+    for (const auto& stamp : stamps) {
+        writer.putString(stamp.name);
+        writer.put(stamp.size);
+        writer.put(stamp.modified);
+    }
+    return encoded;
+}
+
+std::string StateImage::begin(const FileManager& fileManager) {
+    std::string sources = describeSources(fileManager);
+
+    std::string image(MAGIC, sizeof(MAGIC));
+    BinaryWriter writer(image);
+    writer.put(FORMAT_VERSION);
+    writer.put(BYTE_ORDER_MARK);
+    writer.put(static_cast<std::uint32_t>(FIXED_HEADER_SIZE + sources.size()));
+    writer.put(std::uint64_t{0});   // Payload size, set by commit()
+    writer.put(std::uint32_t{0});   // Payload checksum, set by commit()
+    image += sources;
+    return image;
+}
+
+bool StateImage::commit(const FileManager& fileManager, std::string& image) {
+    if (image.size() < FIXED_HEADER_SIZE) {
+        return false;
+    }
+
+    std::uint32_t headerSize = 0;
+    std::memcpy(&headerSize, image.data() + HEADER_SIZE_OFFSET, sizeof(headerSize));
+    std::string_view payload = std::string_view(image).substr(headerSize);
+
+    std::uint64_t payloadSize = payload.size();
+    std::uint32_t sum = FileManager::checksum(payload);
+    std::memcpy(&image[PAYLOAD_SIZE_OFFSET], &payloadSize, sizeof(payloadSize));
+    std::memcpy(&image[CHECKSUM_OFFSET], &sum, sizeof(sum));
+
+    return fileManager.writeBuffer(FILENAME, image);
+}
+
+bool StateImage::open(const FileManager& fileManager, MappedFile& file, std::string_view& payload) {
+    file = fileManager.mapFile(FILENAME);
+    std::string_view image = file.data();
+    if (!file.isOpen() || image.size() < FIXED_HEADER_SIZE ||
+        std::memcmp(image.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+
+    BinaryReader header(image.substr(sizeof(MAGIC), FIXED_HEADER_SIZE - sizeof(MAGIC)));
+    std::uint32_t version = header.get<std::uint32_t>();
+    std::uint32_t byteOrder = header.get<std::uint32_t>();
+    std::uint32_t headerSize = header.get<std::uint32_t>();
+    std::uint64_t payloadSize = header.get<std::uint64_t>();
+    std::uint32_t sum = header.get<std::uint32_t>();
+
+    if (version != FORMAT_VERSION || byteOrder != BYTE_ORDER_MARK ||
+        headerSize < FIXED_HEADER_SIZE || headerSize > image.size() ||
+        payloadSize != image.size() - headerSize) {
+        return false;
+    }
+
+    // Stale if any data file was written after the image
+    std::string_view sources = image.substr(FIXED_HEADER_SIZE, headerSize - FIXED_HEADER_SIZE);
+    if (sources != describeSources(fileManager)) {
+        return false;
+    }
+
+    payload = image.substr(headerSize);
+    return FileManager::checksum(payload) == sum;
+}
+
+bool StateImage::discard(const FileManager& fileManager) {
+    return fileManager.removeFile(FILENAME);
+}
@@ -0,0 +1,92 @@
+/**
+ * @file StateImage.h
+ * @brief Binary image of the whole in-memory state for fast startup
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only frames, validates and stores the image
+ * - Open/Closed: Controllers add their own sections without changing it
+ */
+
+#ifndef STATEIMAGE_H
+#define STATEIMAGE_H
+
+#include "FileManager.h"
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @class StateImage
+ * @brief Reads and writes state.bin, a cache of the parsed data files
+ *
+ * The image is written on clean shutdown and holds every controller's
+ * state in a fixed-width binary form that loads without text parsing. It
+ * is only a cache: the text files stay authoritative. The header records
+ * the name, size and modification time of every file in the data
+ * directory, and open() refuses the image if any of them changed since,
+ * or if the payload checksum does not match.
+ *
+ * Layout: magic | version | byte order mark | header size | payload size |
+ * payload CRC-32 | source file stamps | payload
+ */
+class StateImage {
+private:
+    static constexpr char MAGIC[8] = {'S', 'K', 'E', 'N', 'A', 'I', 'M', 'G'};
+    static constexpr std::uint32_t FORMAT_VERSION = 2;
+    static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304u;
+    static constexpr std::size_t HEADER_SIZE_OFFSET = 16;   ///< After magic, version, mark
+    static constexpr std::size_t PAYLOAD_SIZE_OFFSET = 20;  ///< After the header size
+    static constexpr std::size_t CHECKSUM_OFFSET = 28;      ///< After the payload size
+    static constexpr std::size_t FIXED_HEADER_SIZE = 32;    ///< Bytes before the source stamps
+
+    /**
+     * @brief Describes the current data files
+     * @param fileManager File I/O handler (gives the data directory)
+     * @return Encoded name, size and modification time of each file, by name
+     */
+    static std::string describeSources(const FileManager& fileManager);
+
+    // Static utility class - no instances
+    StateImage() = delete;
+
+public:
+    static constexpr const char* FILENAME = "state.bin";
+
+    /**
+     * @brief Starts an image buffer
+     * @param fileManager File I/O handler
+     * @return Buffer holding the header; append the payload, then commit()
+     *
+     * Call once every data file has been written, since the header stamps
+     * the files as they are now.
+     */
+    static std::string begin(const FileManager& fileManager);
+
+    /**
+     * @brief Seals the header of a finished buffer and writes state.bin
+     * @param fileManager File I/O handler
+     * @param image Buffer from begin() with the payload appended
+     * @return true if written
+     */
+    static bool commit(const FileManager& fileManager, std::string& image);
+
+    /**
+     * @brief Maps state.bin and validates it against the data files
+     * @param fileManager File I/O handler
+     * @param file Receives the mapping, which must outlive payload
+     * @param payload Receives the payload bytes
+     * @return true if the image exists, is intact and is up to date
+     */
+    static bool open(const FileManager& fileManager, MappedFile& file, std::string_view& payload);
+
+    /**
+     * @brief Deletes state.bin
+     * @param fileManager File I/O handler
+     * @return true if no image is left
+     */
+    static bool discard(const FileManager& fileManager);
+};
+
+#endif // STATEIMAGE_H
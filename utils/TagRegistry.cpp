@@ -0,0 +1,39 @@
+/**
+ * @file TagRegistry.cpp
+ * @brief Implementation of TagRegistry class
+ */
+
+#include "TagRegistry.h"
+#include <limits>
+
+TagRegistry::TagRegistry() {
+    intern("");
+}
+
+TagRegistry& TagRegistry::getInstance() {
+    static TagRegistry instance;
+    return instance;
+}
+
+TagRegistry::Tag TagRegistry::intern(std::string_view name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_tags.find(name);
+    if (it != m_tags.end()) {
+        return it->second;
+    }
+
+    // A wrapped tag would alias an existing value
+    if (m_names.size() > std::numeric_limits<Tag>::max()) {
+        return 0;
+    }
+
+    Tag tag = static_cast<Tag>(m_names.size());
+    m_names.emplace_back(name);
+    m_tags.emplace(m_names.back(), tag);
+    return tag;
+}
+
+const std::string& TagRegistry::getName(Tag tag) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (tag < m_names.size()) ? m_names[tag] : m_names.front();
+}
@@ -0,0 +1,71 @@
+/**
+ * @file TagRegistry.h
+ * @brief Interns short attribute strings as small integer tags
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only maps tag text to and from identifiers
+ */
+
+#ifndef TAGREGISTRY_H
+#define TAGREGISTRY_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @class TagRegistry
+ * @brief Maps attribute values such as "double" or "pastry" to tags
+ *
+ * Products hold a two-byte tag instead of their own copy of a value that
+ * only ever takes a handful of distinct values. Text is looked up only
+ * when reading or writing files and when displaying. Tag 0 is the empty
+ * string. Interned strings are never removed, so references returned by
+ * getName() stay valid for the life of the program.
+ *
+ * Products are built on checkout and loader threads as well as the GUI
+ * thread, so every method takes the registry's lock.
+ */
+class TagRegistry {
+public:
+    using Tag = std::uint16_t;
+
+private:
+    std::deque<std::string> m_names;                   ///< Tag -> text (deque keeps references stable)
+    std::unordered_map<std::string_view, Tag> m_tags;  ///< Text -> tag, viewing into m_names
+    mutable std::mutex m_mutex;                        ///< Guards m_names and m_tags
+
+    // Private constructor for singleton pattern
+    TagRegistry();
+
+public:
+    // Delete copy constructor and assignment operator
+    TagRegistry(const TagRegistry&) = delete;
+    TagRegistry& operator=(const TagRegistry&) = delete;
+
+    /**
+     * @brief Gets the singleton instance
+     * @return Reference to the TagRegistry instance
+     */
+    static TagRegistry& getInstance();
+
+    /**
+     * @brief Gets the tag for a value, registering it if new
+     * @param name Value text
+     * @return Tag for the value; 0 (the empty string) if the value is new
+     *         and every tag is already taken
+     */
+    Tag intern(std::string_view name);
+
+    /**
+     * @brief Gets the text of a tag
+     * @param tag Tag returned by intern()
+     * @return Value text (empty for unknown tags)
+     */
+    const std::string& getName(Tag tag) const;
+};
+
+#endif // TAGREGISTRY_H
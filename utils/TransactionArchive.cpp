@@ -0,0 +1,234 @@
+/**
+ * @file TransactionArchive.cpp
+ * @brief Implementation of TransactionArchive class
+ */
+
+#include "TransactionArchive.h"
+#include "BinaryIO.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace {
+
+// Appends a column's values for one block and fills in its directory entry
+// (offset relative to the start of the column's data for now)
+void encodeChunk(const std::vector<std::int64_t>& values, bool delta,
+                 std::string& columnData, ArchiveChunk& chunk) {
+    chunk.offset = columnData.size();
+    chunk.count = static_cast<std::uint32_t>(values.size());
+    if (!values.empty()) {
+        auto [low, high] = std::minmax_element(values.begin(), values.end());
+        chunk.min = *low;
+        chunk.max = *high;
+    }
+
+    BinaryWriter writer(columnData);
+    std::int64_t previous = 0;
+    for (std::int64_t value : values) {
+        writer.putSignedVarint(delta ? value - previous : value);
+        previous = value;
+    }
+
+    std::string_view encoded = std::string_view(columnData).substr(chunk.offset);
+    chunk.size = static_cast<std::uint32_t>(encoded.size());
+    chunk.crc = FileManager::checksum(encoded);
+}
+
+} // namespace
+
+TransactionArchive::TransactionArchive()
+    : m_blockCount(0)
+    , m_rowCount(0)
+    , m_generation(0)
+{
+}
+
+bool TransactionArchive::isDeltaEncoded(ArchiveColumn column) {
+    return column == ArchiveColumn::Id ||
+           column == ArchiveColumn::Timestamp ||
+           column == ArchiveColumn::ItemOffset;
+}
+
+std::string TransactionArchive::encode(const std::vector<const Transaction*>& transactions,
+                                      std::uint64_t generation) {
+    std::size_t blockCount = (transactions.size() + BLOCK_ROWS - 1) / BLOCK_ROWS;
+    std::vector<ArchiveChunk> chunks(blockCount * ARCHIVE_COLUMN_COUNT);
+    std::array<std::string, ARCHIVE_COLUMN_COUNT> columnData;
+    std::array<std::vector<std::int64_t>, ARCHIVE_COLUMN_COUNT> values;
+
+    auto column = [&values](ArchiveColumn c) -> std::vector<std::int64_t>& {
+        return values[static_cast<std::size_t>(c)];
+    };
+
+    for (std::size_t block = 0; block < blockCount; ++block) {
+        for (auto& list : values) {
+            list.clear();
+        }
+
+        std::size_t first = block * BLOCK_ROWS;
+        std::size_t last = std::min(first + BLOCK_ROWS, transactions.size());
+        for (std::size_t row = first; row < last; ++row) {
+            const Transaction& transaction = *transactions[row];
+            column(ArchiveColumn::Id).push_back(transaction.getId());
+            column(ArchiveColumn::Timestamp).push_back(transaction.getTimestamp());
+            column(ArchiveColumn::CustomerId).push_back(transaction.getCustomerId());
+            column(ArchiveColumn::Total).push_back(transaction.getTotal());
+            column(ArchiveColumn::PointsEarned).push_back(transaction.getPointsEarned());
+            column(ArchiveColumn::PointsUsed).push_back(transaction.getPointsUsed());
+
+            for (const auto& item : transaction.getItems()) {
+                column(ArchiveColumn::ItemProduct).push_back(item.getProductId());
+                column(ArchiveColumn::ItemQuantity).push_back(item.getQuantity());
+            }
+            column(ArchiveColumn::ItemOffset).push_back(
+                static_cast<std::int64_t>(column(ArchiveColumn::ItemProduct).size()));
+        }
+
+        for (std::size_t c = 0; c < ARCHIVE_COLUMN_COUNT; ++c) {
+            encodeChunk(values[c], isDeltaEncoded(static_cast<ArchiveColumn>(c)),
+                        columnData[c], chunks[block * ARCHIVE_COLUMN_COUNT + c]);
+        }
+    }
+
+    // Columns are laid out one after another, so make offsets absolute
+    std::uint64_t columnStart = HEADER_SIZE + chunks.size() * CHUNK_SIZE;
+    for (std::size_t c = 0; c < ARCHIVE_COLUMN_COUNT; ++c) {
+        for (std::size_t block = 0; block < blockCount; ++block) {
+            chunks[block * ARCHIVE_COLUMN_COUNT + c].offset += columnStart;
+        }
+        columnStart += columnData[c].size();
+    }
+
+    std::string directory;
+    directory.reserve(chunks.size() * CHUNK_SIZE);
+    BinaryWriter directoryWriter(directory);
+    for (const auto& chunk : chunks) {
+        directoryWriter.put(chunk.offset);
+        directoryWriter.put(chunk.size);
+        directoryWriter.put(chunk.count);
+        directoryWriter.put(chunk.crc);
+        directoryWriter.put(chunk.min);
+        directoryWriter.put(chunk.max);
+    }
+
+    std::string file(MAGIC, sizeof(MAGIC));
+    file.reserve(static_cast<std::size_t>(columnStart));
+    BinaryWriter writer(file);
+    writer.put(FORMAT_VERSION);
+    writer.put(BYTE_ORDER_MARK);
+    writer.put(static_cast<std::uint32_t>(ARCHIVE_COLUMN_COUNT));
+    writer.put(static_cast<std::uint32_t>(blockCount));
+    writer.put(static_cast<std::uint64_t>(transactions.size()));
+    writer.put(generation);
+    writer.put(FileManager::checksum(directory));
+    file += directory;
+    for (const auto& data : columnData) {
+        file += data;
+    }
+    return file;
+}
+
+bool TransactionArchive::open(const FileManager& fileManager, const std::string& filename) {
+    m_file = fileManager.mapFile(filename);
+    m_chunks.clear();
+    m_blockCount = 0;
+    m_rowCount = 0;
+    m_generation = 0;
+
+    std::string_view data = m_file.data();
+    if (!m_file.isOpen() || data.size() < HEADER_SIZE ||
+        std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+
+    BinaryReader header(data.substr(sizeof(MAGIC), HEADER_SIZE - sizeof(MAGIC)));
+    std::uint32_t version = header.get<std::uint32_t>();
+    std::uint32_t byteOrder = header.get<std::uint32_t>();
+    std::uint32_t columnCount = header.get<std::uint32_t>();
+    std::uint32_t blockCount = header.get<std::uint32_t>();
+    std::uint64_t rowCount = header.get<std::uint64_t>();
+    std::uint64_t generation = header.get<std::uint64_t>();
+    std::uint32_t directoryCrc = header.get<std::uint32_t>();
+
+    std::uint64_t directorySize = static_cast<std::uint64_t>(blockCount) * ARCHIVE_COLUMN_COUNT * CHUNK_SIZE;
+    if (version != FORMAT_VERSION || byteOrder != BYTE_ORDER_MARK ||
+        columnCount != ARCHIVE_COLUMN_COUNT || directorySize > data.size() - HEADER_SIZE) {
+        return false;
+    }
+
+    std::string_view directory = data.substr(HEADER_SIZE, static_cast<std::size_t>(directorySize));
+    if (FileManager::checksum(directory) != directoryCrc) {
+        return false;
+    }
+
+    BinaryReader reader(directory);
+    m_chunks.resize(static_cast<std::size_t>(blockCount) * ARCHIVE_COLUMN_COUNT);
+    for (auto& chunk : m_chunks) {
+        chunk.offset = reader.get<std::uint64_t>();
+        chunk.size = reader.get<std::uint32_t>();
+        chunk.count = reader.get<std::uint32_t>();
+        chunk.crc = reader.get<std::uint32_t>();
+        chunk.min = reader.get<std::int64_t>();
+        chunk.max = reader.get<std::int64_t>();
+    }
+
+    m_blockCount = blockCount;
+    m_rowCount = rowCount;
+    m_generation = generation;
+    return reader.ok();
+}
+
+bool TransactionArchive::isOpen() const {
+    return m_file.isOpen() && !m_chunks.empty();
+}
+
+std::uint64_t TransactionArchive::getRowCount() const {
+    return m_rowCount;
+}
+
+std::size_t TransactionArchive::getBlockCount() const {
+    return m_blockCount;
+}
+
+std::uint64_t TransactionArchive::getGeneration() const {
+    return m_generation;
+}
+
+const ArchiveChunk& TransactionArchive::getChunk(std::size_t block, ArchiveColumn column) const {
+    return m_chunks[block * ARCHIVE_COLUMN_COUNT + static_cast<std::size_t>(column)];
+}
+
+bool TransactionArchive::readColumn(std::size_t block, ArchiveColumn column,
+                                    std::vector<std::int64_t>& values) const {
+    values.clear();
+    if (block >= m_blockCount) {
+        return false;
+    }
+
+    const ArchiveChunk& chunk = getChunk(block, column);
+    std::string_view data = m_file.data();
+    if (chunk.offset > data.size() || chunk.size > data.size() - chunk.offset) {
+        return false;
+    }
+
+    std::string_view encoded = data.substr(static_cast<std::size_t>(chunk.offset), chunk.size);
+    if (FileManager::checksum(encoded) != chunk.crc) {
+        return false;
+    }
+
+    bool delta = isDeltaEncoded(column);
+    BinaryReader reader(encoded);
+    values.reserve(chunk.count);
+    std::int64_t previous = 0;
+    for (std::uint32_t i = 0; i < chunk.count; ++i) {
+        std::int64_t value = reader.getSignedVarint();
+        if (delta) {
+            value += previous;
+        }
+        values.push_back(value);
+        previous = value;
+    }
+
+    return reader.ok() && reader.atEnd();
+}
@@ -0,0 +1,146 @@
+/**
+ * @file TransactionArchive.h
+ * @brief Columnar archive file of the transactions of one closed period
+ *
+ * SOLID Principles Applied:
+ * - Single Responsibility: Only encodes, validates and decodes archive columns
+ * - Interface Segregation: Readers decode just the columns and blocks they use
+ */
+
+#ifndef TRANSACTIONARCHIVE_H
+#define TRANSACTIONARCHIVE_H
+
+#include "FileManager.h"
+#include "MappedFile.h"
+#include "../models/Transaction.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @enum ArchiveColumn
+ * @brief Columns stored in a TransactionArchive
+ *
+ * The first six hold one value per transaction. ItemOffset holds, per
+ * transaction, the end of its items within the block's ItemProduct and
+ * ItemQuantity columns, which hold one value per item line.
+ */
+enum class ArchiveColumn {
+    Id,
+    Timestamp,
+    CustomerId,
+    Total,
+    PointsEarned,
+    PointsUsed,
+    ItemOffset,
+    ItemProduct,
+    ItemQuantity
+};
+
+constexpr std::size_t ARCHIVE_COLUMN_COUNT = 9;  ///< Number of ArchiveColumn values
+
+/**
+ * @struct ArchiveChunk
+ * @brief Location and statistics of one column within one block
+ */
+struct ArchiveChunk {
+    std::uint64_t offset = 0;  ///< Byte offset of the encoded values in the file
+    std::uint32_t size = 0;    ///< Encoded size in bytes
+    std::uint32_t count = 0;   ///< Number of values
+    std::uint32_t crc = 0;     ///< CRC-32 of the encoded bytes
+    std::int64_t min = 0;      ///< Smallest value (0 if empty)
+    std::int64_t max = 0;      ///< Largest value (0 if empty)
+};
+
+/**
+ * @class TransactionArchive
+ * @brief Read-only, column-oriented copy of a period's transactions
+ *
+ * Rows are cut into blocks of BLOCK_ROWS transactions. Within a block each
+ * column is stored separately as varints: Id, Timestamp and ItemOffset as
+ * deltas from the previous value (small, since rows are in time order),
+ * the rest as zigzag values. A directory up front gives every chunk's
+ * offset, CRC and min/max, so a scan maps the file, skips blocks whose
+ * stats rule them out and decodes only the columns it needs; the pages of
+ * other columns are never read.
+ *
+ * The header also carries the generation its writer gave the period, so a
+ * reader can tell an archive encoded before the period last changed.
+ *
+ * Layout: magic | version | byte order mark | column count | block count |
+ * row count | generation | directory CRC-32 | directory (block-major) |
+ * column data (column-major)
+ */
+class TransactionArchive {
+private:
+    static constexpr char MAGIC[8] = {'S', 'K', 'E', 'N', 'A', 'C', 'O', 'L'};
+    static constexpr std::uint32_t FORMAT_VERSION = 2;
+    static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304u;
+    static constexpr std::size_t HEADER_SIZE = 44;  ///< Bytes before the directory
+    static constexpr std::size_t CHUNK_SIZE = 36;   ///< Bytes per directory entry
+
+    MappedFile m_file;                   ///< Mapped archive
+    std::vector<ArchiveChunk> m_chunks;  ///< Directory, block-major
+    std::size_t m_blockCount;            ///< Number of blocks
+    std::uint64_t m_rowCount;            ///< Number of transactions
+    std::uint64_t m_generation;          ///< Writer's generation of the period
+
+    /**
+     * @brief Checks whether a column is stored as deltas
+     */
+    static bool isDeltaEncoded(ArchiveColumn column);
+
+public:
+    static constexpr std::size_t BLOCK_ROWS = 4096;  ///< Transactions per block
+
+    /**
+     * @brief Constructs a closed archive
+     */
+    TransactionArchive();
+
+    /**
+     * @brief Encodes transactions into archive format
+     * @param transactions Transactions in time order
+     * @param generation Generation of the period, stored in the header
+     * @return File content, ready for FileManager::writeBuffer()
+     */
+    static std::string encode(const std::vector<const Transaction*>& transactions,
+                              std::uint64_t generation);
+
+    /**
+     * @brief Maps an archive file and reads its directory
+     * @param fileManager File I/O handler
+     * @param filename Name of the archive (relative to data path)
+     * @return true if the file exists and its header and directory are intact
+     */
+    bool open(const FileManager& fileManager, const std::string& filename);
+
+    /**
+     * @brief Checks if an archive is open
+     */
+    bool isOpen() const;
+
+    // ============ Getters ============
+    std::uint64_t getRowCount() const;
+    std::size_t getBlockCount() const;
+    std::uint64_t getGeneration() const;
+
+    /**
+     * @brief Gets the location and min/max of one column in one block
+     * @param block Block index (< getBlockCount())
+     * @param column Column
+     */
+    const ArchiveChunk& getChunk(std::size_t block, ArchiveColumn column) const;
+
+    /**
+     * @brief Decodes one column of one block
+     * @param block Block index (< getBlockCount())
+     * @param column Column
+     * @param values Receives the values (replacing its contents)
+     * @return false if the chunk is out of bounds or fails its checksum
+     */
+    bool readColumn(std::size_t block, ArchiveColumn column, std::vector<std::int64_t>& values) const;
+};
+
+#endif // TRANSACTIONARCHIVE_H
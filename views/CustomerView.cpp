@@ -9,6 +9,7 @@
 #include <QFormLayout>
 #include <QHeaderView>
 #include <QMessageBox>
+#include <QSignalBlocker>
 
 CustomerView::CustomerView(CustomerController* controller, QWidget* parent)
     : QWidget(parent)
@@ -27,7 +28,7 @@ void CustomerView::setupUI() {
     QHBoxLayout* searchLayout = new QHBoxLayout();
     searchLayout->addWidget(new QLabel("Search:"));
     m_searchEdit = new QLineEdit();
-    m_searchEdit->setPlaceholderText("Search by name...");
+    m_searchEdit->setPlaceholderText("Search by name or phone...");
     searchLayout->addWidget(m_searchEdit);
     m_searchButton = new QPushButton("Search");
     searchLayout->addWidget(m_searchButton);
@@ -110,6 +111,8 @@ void CustomerView::connectSignals() {
     connect(m_clearButton, &QPushButton::clicked, this, &CustomerView::onClearForm);
     connect(m_searchButton, &QPushButton::clicked, this, &CustomerView::onSearch);
     connect(m_searchEdit, &QLineEdit::returnPressed, this, &CustomerView::onSearch);
+    // Both searches are index lookups, so results can follow every keystroke
+    connect(m_searchEdit, &QLineEdit::textChanged, this, &CustomerView::onSearch);
     connect(m_addPointsButton, &QPushButton::clicked, this, &CustomerView::onAddPoints);
     connect(m_customerTable, &QTableWidget::itemSelectionChanged,
             this, &CustomerView::onTableRowSelected);
@@ -154,6 +157,9 @@ void CustomerView::refreshTable() {
     }
 
     m_customerTable->resizeColumnsToContents();
+
+    // Clearing the box must not re-run onSearch and refresh a second time
+    QSignalBlocker blocker(m_searchEdit);
     m_searchEdit->clear();
 }
 
@@ -190,14 +196,20 @@ void CustomerView::onEditCustomer() {
         return;
     }
 
-    Customer* customer = m_controller->getById(m_selectedCustomerId);
-    if (!customer) {
+    const Customer* existing = m_controller->getById(m_selectedCustomerId);
+    if (!existing) {
         QMessageBox::warning(this, "Error", "Customer not found.");
         return;
     }
 
-    customer->setName(name.toStdString());
-    customer->setPhone(m_phoneEdit->text().toStdString());
+    // Go through update() so the controller can reindex a changed phone number
+    Customer customer = *existing;
+    customer.setName(name.toStdString());
+    customer.setPhone(m_phoneEdit->text().toStdString());
+    if (!m_controller->update(customer)) {
+        QMessageBox::warning(this, "Error", "Failed to update customer.");
+        return;
+    }
 
     refreshTable();
     clearForm();
@@ -257,7 +269,18 @@ void CustomerView::onSearch() {
 
     m_customerTable->setRowCount(0);
 
-    std::vector<Customer*> results = m_controller->searchByName(searchTerm.toStdString());
+    // Terms made of phone characters search by phone prefix, anything else by name
+    bool isPhone = true;
+    for (const QChar& c : searchTerm) {
+        if (!c.isDigit() && c != '+' && c != '-' && c != ' ') {
+            isPhone = false;
+            break;
+        }
+    }
+
+    std::vector<Customer*> results = isPhone
+        ? m_controller->searchByPhonePrefix(searchTerm.toStdString())
+        : m_controller->searchByName(searchTerm.toStdString());
 
     for (const auto* customer : results) {
         int row = m_customerTable->rowCount();
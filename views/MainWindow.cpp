@@ -4,17 +4,24 @@
  */
 
 #include "MainWindow.h"
+#include "../utils/DateTime.h"
+#include "../utils/IdGenerator.h"
+#include "../utils/StateImage.h"
+#include "../utils/BinaryIO.h"
 #include <QMenuBar>
 #include <QStatusBar>
 #include <QMessageBox>
 #include <QCloseEvent>
 #include <QApplication>
+#include <QElapsedTimer>
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
+    , m_saveFailed(false)
 {
     // Initialize utilities
     m_fileManager = new FileManager("data/");
+    m_writer = new BackgroundWriter(*m_fileManager);
 
     // Initialize controllers with dependency injection (SOLID: Dependency Inversion)
     m_productController = new ProductController(*m_fileManager);
@@ -38,8 +45,14 @@ MainWindow::MainWindow(QWidget* parent)
 }
 
 MainWindow::~MainWindow() {
-    // Save data before closing
+    // Save data before closing; deleting the writer waits for it to finish
     onSave();
+    delete m_writer;
+
+    // Only a clean shutdown leaves files the image can vouch for
+    if (!m_saveFailed) {
+        saveStateImage();
+    }
 
     // Clean up controllers
     delete m_transactionController;
@@ -100,6 +113,7 @@ void MainWindow::connectSignals() {
     connect(m_loadAction, &QAction::triggered, this, &MainWindow::onLoad);
     connect(m_exitAction, &QAction::triggered, this, &QMainWindow::close);
     connect(m_aboutAction, &QAction::triggered, this, &MainWindow::onAbout);
+    connect(this, &MainWindow::saveCompleted, this, &MainWindow::onSaveCompleted);
 
     // Data change signals
     connect(m_productView, &ProductView::dataChanged, this, &MainWindow::onDataChanged);
@@ -116,10 +130,15 @@ void MainWindow::connectSignals() {
 }
 
 void MainWindow::initializeData() {
-    // Load all data from files
-    m_productController->loadFromFile();
-    m_customerController->loadFromFile();
-    m_transactionController->loadFromFile();
+    // Prefer the image from the last clean shutdown; otherwise load all
+    // data from files (saved ID counters first, so IDs of deleted
+    // entities are never reissued)
+    if (!loadStateImage()) {
+        IdGenerator::getInstance().loadFromFile(*m_fileManager);
+        m_productController->loadFromFile();
+        m_customerController->loadFromFile();
+        m_transactionController->loadFromFile();
+    }
 
     // Refresh all views
     m_productView->refreshTable();
@@ -130,6 +149,41 @@ void MainWindow::initializeData() {
     statusBar()->showMessage("Data loaded successfully", 3000);
 }
 
+bool MainWindow::loadStateImage() {
+    MappedFile file;
+    std::string_view payload;
+    if (!StateImage::open(*m_fileManager, file, payload)) {
+        return false;
+    }
+
+    // Sections in the order saveStateImage() writes them
+    BinaryReader reader(payload);
+    bool loaded = IdGenerator::getInstance().readImage(reader) &&
+                  m_productController->readImage(reader) &&
+                  m_customerController->readImage(reader) &&
+                  m_transactionController->readImage(reader) &&
+                  reader.atEnd();
+
+    if (!loaded) {
+        // Never trust it again; the text files reload below
+        StateImage::discard(*m_fileManager);
+    }
+    return loaded;
+}
+
+void MainWindow::saveStateImage() {
+    std::string image = StateImage::begin(*m_fileManager);
+    BinaryWriter writer(image);
+    IdGenerator::getInstance().writeImage(writer);
+    m_productController->writeImage(writer);
+    m_customerController->writeImage(writer);
+    m_transactionController->writeImage(writer);
+
+    if (!StateImage::commit(*m_fileManager, image)) {
+        StateImage::discard(*m_fileManager);
+    }
+}
+
 void MainWindow::closeEvent(QCloseEvent* event) {
     // Ask to save before closing
     QMessageBox::StandardButton reply = QMessageBox::question(
@@ -149,20 +203,67 @@ void MainWindow::closeEvent(QCloseEvent* event) {
 }
 
 void MainWindow::onSave() {
-    bool success = true;
+    QElapsedTimer timer;
+    timer.start();
+
+    // Only records changed since the last save are serialized; the file
+    // writes happen on the writer thread so the till keeps working meanwhile
+    SaveBatch batch;
+
+    // Sales are already in the transaction log; checkpoint only to compact it.
+    // Rotate the log before taking customer changes, so every balance the
+    // retired log carries is in this batch too
+    int generation = 0;
+    std::vector<PendingFile> checkpoint;
+    if (m_transactionController->needsCheckpoint()) {
+        checkpoint = m_transactionController->beginCheckpoint(generation);
+    }
 
-    if (!m_productController->saveToFile()) {
-        success = false;
+    for (auto& file : m_productController->snapshotChanges()) {
+        batch.files.push_back(std::move(file));
+    }
+    for (auto& file : m_customerController->snapshotChanges()) {
+        batch.files.push_back(std::move(file));
+    }
+    for (auto& file : checkpoint) {
+        batch.files.push_back(std::move(file));
     }
-    if (!m_customerController->saveToFile()) {
-        success = false;
+
+    // Columnar archives of closed months, for reporting scans
+    for (auto& file : m_transactionController->snapshotArchives()) {
+        batch.files.push_back(std::move(file));
     }
-    if (!m_transactionController->saveToFile()) {
-        success = false;
+    batch.files.push_back(IdGenerator::getInstance().snapshot());
+
+    batch.onComplete = [this, generation, timer](bool success) {
+        if (!success) {
+            m_saveFailed = true;
+        }
+        if (generation > 0) {
+            m_transactionController->finishCheckpoint(generation, success);
+        }
+
+        // Hop back to the GUI thread before touching any widgets
+        qint64 elapsedMs = timer.elapsed();
+        QMetaObject::invokeMethod(this, [this, success, elapsedMs]() {
+            emit saveCompleted(success, elapsedMs);
+        }, Qt::QueuedConnection);
+    };
+
+    m_writer->submit(std::move(batch));
+    statusBar()->showMessage("Saving...");
+}
+
+void MainWindow::onSaveCompleted(bool success, qint64 elapsedMs) {
+    if (!success) {
+        // The failed batch's changes were already taken; rewrite in full next time
+        m_productController->requireFullSave();
+        m_customerController->requireFullSave();
+        m_transactionController->scanArchives();
     }
 
     if (success) {
-        statusBar()->showMessage("All data saved successfully", 3000);
+        statusBar()->showMessage(QString("All data saved in %1 ms").arg(elapsedMs), 3000);
     } else {
         statusBar()->showMessage("Error saving some data", 3000);
         QMessageBox::warning(this, "Save Error",
@@ -178,6 +279,8 @@ void MainWindow::onLoad() {
     );
 
     if (reply == QMessageBox::Yes) {
+        // Let any save in progress land before reading the files back
+        m_writer->waitIdle();
         initializeData();
     }
 }
@@ -218,10 +321,16 @@ void MainWindow::onAbout() {
 }
 
 void MainWindow::updateStatusBar() {
-    QString status = QString("Products: %1 | Customers: %2 | Transactions: %3")
+    const SalesAggregates& sales = m_transactionController->getAggregates();
+    SalesTotals today = sales.getDay(DateTime::now());
+
+    QString status = QString("Products: %1 | Customers: %2 | Transactions: %3 | "
+                             "Today: Rp %4 | Total: Rp %5")
         .arg(m_productController->getCount())
         .arg(m_customerController->getCount())
-        .arg(m_transactionController->getCount());
+        .arg(m_transactionController->getCount())
+        .arg(today.revenue)
+        .arg(m_transactionController->getTotalRevenue());
 
     statusBar()->showMessage(status);
 }
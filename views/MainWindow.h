@@ -20,6 +20,8 @@
 #include "../controllers/CustomerController.h"
 #include "../controllers/TransactionController.h"
 #include "../utils/FileManager.h"
+#include "../utils/BackgroundWriter.h"
+#include <atomic>
 
 /**
  * @class MainWindow
@@ -34,6 +36,8 @@ class MainWindow : public QMainWindow {
 private:
     // Utilities (owned)
     FileManager* m_fileManager;
+    BackgroundWriter* m_writer;
+    std::atomic<bool> m_saveFailed;  ///< A background save failed this session
 
     // Controllers (owned)
     ProductController* m_productController;
@@ -77,6 +81,20 @@ private:
      */
     void initializeData();
 
+    /**
+     * @brief Loads every controller from state.bin
+     * @return false if the image is missing, stale or damaged
+     */
+    bool loadStateImage();
+
+    /**
+     * @brief Writes state.bin from the in-memory state
+     *
+     * Call only after every save has reached disk, since the image
+     * records the data files as they are at this moment.
+     */
+    void saveStateImage();
+
 public:
     /**
      * @brief Constructs the MainWindow
@@ -85,10 +103,19 @@ public:
     explicit MainWindow(QWidget* parent = nullptr);
 
     /**
-     * @brief Destructor - saves data before closing
+     * @brief Destructor - saves data, waits for it to reach disk, then
+     *        writes the state image for the next fast start
      */
     ~MainWindow() override;
 
+signals:
+    /**
+     * @brief Emitted on the GUI thread once a background save has finished
+     * @param success true if every file was written
+     * @param elapsedMs Time from pressing save until the files were durable
+     */
+    void saveCompleted(bool success, qint64 elapsedMs);
+
 protected:
     /**
      * @brief Handles close event - prompts to save
@@ -98,10 +125,17 @@ protected:
 
 private slots:
     /**
-     * @brief Saves all data to files
+     * @brief Snapshots all data and hands it to the background writer
      */
     void onSave();
 
+    /**
+     * @brief Reports the result and latency of a background save
+     * @param success true if every file was written
+     * @param elapsedMs Time from pressing save until the files were durable
+     */
+    void onSaveCompleted(bool success, qint64 elapsedMs);
+
     /**
      * @brief Loads all data from files
      */
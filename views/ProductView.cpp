@@ -9,6 +9,7 @@
 #include <QFormLayout>
 #include <QHeaderView>
 #include <QMessageBox>
+#include <cmath>
 
 ProductView::ProductView(ProductController* controller, QWidget* parent)
     : QWidget(parent)
@@ -133,7 +134,7 @@ void ProductView::populateForm(const Product* product) {
     if (!product) return;
 
     m_nameEdit->setText(QString::fromStdString(product->getName()));
-    m_priceSpinBox->setValue(product->getPrice());
+    m_priceSpinBox->setValue(static_cast<double>(product->getPrice()));
 
     int typeIndex = m_typeComboBox->findData(QString::fromStdString(product->getType()));
     if (typeIndex >= 0) {
@@ -150,12 +151,14 @@ void ProductView::refreshTable() {
     m_productTable->setRowCount(0);
 
     QString filterType = m_typeFilter->currentData().toString();
-    std::vector<Product*> products;
+    const ProductController& catalog = *m_controller;
+    std::vector<const Product*> products;
 
     if (filterType == "all") {
-        products = m_controller->getAll();
+        products = catalog.getAll();
     } else {
-        products = m_controller->getByType(filterType.toStdString());
+        auto matching = catalog.getByType(filterType.toStdString());
+        products.assign(matching.begin(), matching.end());
     }
 
     for (const auto* product : products) {
@@ -164,7 +167,7 @@ void ProductView::refreshTable() {
 
         m_productTable->setItem(row, 0, new QTableWidgetItem(QString::number(product->getId())));
         m_productTable->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(product->getName())));
-        m_productTable->setItem(row, 2, new QTableWidgetItem(QString::number(product->getPrice(), 'f', 0)));
+        m_productTable->setItem(row, 2, new QTableWidgetItem(QString::number(product->getPrice())));
         m_productTable->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(product->getType())));
         m_productTable->setItem(row, 4, new QTableWidgetItem(QString::fromStdString(product->getExtraField())));
     }
@@ -179,7 +182,7 @@ void ProductView::onAddProduct() {
         return;
     }
 
-    double price = m_priceSpinBox->value();
+    Money price = std::llround(m_priceSpinBox->value());
     QString type = m_typeComboBox->currentData().toString();
     QString extraField = m_extraFieldEdit->text().trimmed();
 
@@ -222,9 +225,16 @@ void ProductView::onEditProduct() {
         return;
     }
 
-    product->setName(name.toStdString());
-    product->setPrice(m_priceSpinBox->value());
-    product->setExtraField(m_extraFieldEdit->text().toStdString());
+    // Edit a copy and go through update() so the change is tracked for saving
+    std::unique_ptr<Product> edited(product->clone());
+    edited->setName(name.toStdString());
+    edited->setPrice(std::llround(m_priceSpinBox->value()));
+    edited->setExtraField(m_extraFieldEdit->text().toStdString());
+
+    if (!m_controller->update(*edited)) {
+        QMessageBox::warning(this, "Error", "Failed to update product.");
+        return;
+    }
 
     refreshTable();
     clearForm();
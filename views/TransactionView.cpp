@@ -203,26 +203,26 @@ void TransactionView::connectSignals() {
 void TransactionView::updateTotals() {
     const Transaction& trans = m_transactionController->getCurrentTransaction();
 
-    m_subtotalLabel->setText(QString("Rp %1").arg(trans.getSubtotal(), 0, 'f', 0));
-    m_discountLabel->setText(QString("- Rp %1").arg(trans.getDiscount(), 0, 'f', 0));
-    m_totalLabel->setText(QString("Rp %1").arg(trans.getTotal(), 0, 'f', 0));
+    m_subtotalLabel->setText(QString("Rp %1").arg(trans.getSubtotal()));
+    m_discountLabel->setText(QString("- Rp %1").arg(trans.getDiscount()));
+    m_totalLabel->setText(QString("Rp %1").arg(trans.getTotal()));
 }
 
 void TransactionView::updatePointsValue() {
     int points = m_usePointsSpinBox->value();
-    double value = Customer::calculatePointsValue(points);
-    m_pointsValueLabel->setText(QString("= Rp %1 discount").arg(value, 0, 'f', 0));
+    Money value = Customer::calculatePointsValue(points);
+    m_pointsValueLabel->setText(QString("= Rp %1 discount").arg(value));
 }
 
 void TransactionView::refreshProductLists() {
     // Refresh coffee list
     m_coffeeList->clear();
-    std::vector<Product*> coffees = m_productController->getByType("coffee");
+    auto coffees = m_productController->getByType(ProductType::Coffee);
     for (const auto* product : coffees) {
         QListWidgetItem* item = new QListWidgetItem(
             QString("%1 - Rp %2")
                 .arg(QString::fromStdString(product->getName()))
-                .arg(product->getPrice(), 0, 'f', 0)
+                .arg(product->getPrice())
         );
         item->setData(Qt::UserRole, product->getId());
         m_coffeeList->addItem(item);
@@ -230,12 +230,12 @@ void TransactionView::refreshProductLists() {
 
     // Refresh snack list
     m_snackList->clear();
-    std::vector<Product*> snacks = m_productController->getByType("snack");
+    auto snacks = m_productController->getByType(ProductType::Snack);
     for (const auto* product : snacks) {
         QListWidgetItem* item = new QListWidgetItem(
             QString("%1 - Rp %2")
                 .arg(QString::fromStdString(product->getName()))
-                .arg(product->getPrice(), 0, 'f', 0)
+                .arg(product->getPrice())
         );
         item->setData(Qt::UserRole, product->getId());
         m_snackList->addItem(item);
@@ -269,7 +269,7 @@ void TransactionView::refreshCart() {
 
         m_cartTable->setItem(row, 0, new QTableWidgetItem(QString::number(item.getProductId())));
         m_cartTable->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(item.getProductName())));
-        m_cartTable->setItem(row, 2, new QTableWidgetItem(QString("Rp %1").arg(item.getUnitPrice(), 0, 'f', 0)));
+        m_cartTable->setItem(row, 2, new QTableWidgetItem(QString("Rp %1").arg(item.getUnitPrice())));
 
         QSpinBox* qtySpinBox = new QSpinBox();
         qtySpinBox->setRange(1, 99);
@@ -279,7 +279,7 @@ void TransactionView::refreshCart() {
         });
         m_cartTable->setCellWidget(row, 3, qtySpinBox);
 
-        m_cartTable->setItem(row, 4, new QTableWidgetItem(QString("Rp %1").arg(item.getSubtotal(), 0, 'f', 0)));
+        m_cartTable->setItem(row, 4, new QTableWidgetItem(QString("Rp %1").arg(item.getSubtotal())));
     }
 
     m_cartTable->resizeColumnsToContents();
@@ -309,7 +309,7 @@ void TransactionView::refreshHistory() {
         m_historyTable->setItem(row, 2, new QTableWidgetItem(customerName));
 
         m_historyTable->setItem(row, 3, new QTableWidgetItem(QString::number(trans->getItemCount())));
-        m_historyTable->setItem(row, 4, new QTableWidgetItem(QString("Rp %1").arg(trans->getTotal(), 0, 'f', 0)));
+        m_historyTable->setItem(row, 4, new QTableWidgetItem(QString("Rp %1").arg(trans->getTotal())));
         m_historyTable->setItem(row, 5, new QTableWidgetItem(QString::number(trans->getPointsEarned())));
     }
 
@@ -354,9 +354,9 @@ void TransactionView::onCartQuantityChanged(int row, int quantity) {
     m_transactionController->updateCartQuantity(productId, quantity);
 
     // Update subtotal for this row
-    TransactionItem* item = m_transactionController->getCurrentTransaction().getItem(productId);
+    const TransactionItem* item = m_transactionController->getCurrentTransaction().getItem(productId);
     if (item) {
-        m_cartTable->item(row, 4)->setText(QString("Rp %1").arg(item->getSubtotal(), 0, 'f', 0));
+        m_cartTable->item(row, 4)->setText(QString("Rp %1").arg(item->getSubtotal()));
     }
 
     updateTotals();
@@ -411,7 +411,7 @@ void TransactionView::onCompleteTransaction() {
                               "Total: Rp %1\n"
                               "Points to Use: %2\n"
                               "Points to Earn: %3")
-                          .arg(trans.getTotal(), 0, 'f', 0)
+                          .arg(trans.getTotal())
                           .arg(trans.getPointsUsed())
                           .arg(trans.getPointsEarned());
 